@@ -0,0 +1,381 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "block.hpp"
+
+// A single-threaded executor, the default producer for async_block_source.
+class thread_executor {
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::deque<std::function<void ( )>> _tasks;
+    bool _stop = false;
+    std::thread _thread;
+
+    void run ( ) {
+        for ( ;; ) {
+            std::function<void ( )> task;
+            {
+                std::unique_lock<std::mutex> lock ( _mutex );
+                _cv.wait ( lock, [ this ] { return _stop or not _tasks.empty ( ); } );
+                if ( _tasks.empty ( ) )
+                    return;
+                task = std::move ( _tasks.front ( ) );
+                _tasks.pop_front ( );
+            }
+            task ( );
+        }
+    }
+
+    public:
+    thread_executor ( ) : _thread ( [ this ] { run ( ); } ) {}
+
+    thread_executor ( thread_executor && )      = delete;
+    thread_executor ( const thread_executor & ) = delete;
+
+    thread_executor & operator= ( thread_executor && ) = delete;
+    thread_executor & operator= ( const thread_executor & ) = delete;
+
+    // Runs the queued tasks, then joins.
+    ~thread_executor ( ) {
+        {
+            std::lock_guard<std::mutex> lock ( _mutex );
+            _stop = true;
+        }
+        _cv.notify_one ( );
+        _thread.join ( );
+    }
+
+    void post ( std::function<void ( )> task_ ) {
+        {
+            std::lock_guard<std::mutex> lock ( _mutex );
+            _tasks.push_back ( std::move ( task_ ) );
+        }
+        _cv.notify_one ( );
+    }
+};
+
+// A lazy coroutine task: the body starts when the task is awaited ( or
+// sync_wait-ed ), and the awaiting coroutine is resumed, by symmetric transfer,
+// where the body finishes, on whatever thread that is. Exceptions propagate to
+// the awaiter. A task is awaited once.
+template<typename T = void>
+class async_task;
+
+namespace async_detail {
+
+template<typename Task>
+struct final_awaiter {
+    [[nodiscard]] bool await_ready ( ) const noexcept { return false; }
+    template<typename Promise>
+    [[nodiscard]] std::coroutine_handle<> await_suspend ( const std::coroutine_handle<Promise> handle_ ) const noexcept {
+        auto & p = handle_.promise ( );
+        if ( p.continuation )
+            return p.continuation;
+        p.done.store ( true, std::memory_order_release );
+        p.done.notify_all ( );
+        return std::noop_coroutine ( );
+    }
+    void await_resume ( ) const noexcept {}
+};
+
+template<typename T>
+struct promise_base {
+    std::coroutine_handle<> continuation;
+    std::atomic<bool> done{ false };
+    std::exception_ptr error;
+
+    [[nodiscard]] std::suspend_always initial_suspend ( ) const noexcept { return { }; }
+    [[nodiscard]] final_awaiter<T> final_suspend ( ) const noexcept { return { }; }
+    void unhandled_exception ( ) noexcept { error = std::current_exception ( ); }
+};
+
+} // namespace async_detail
+
+template<typename T>
+class async_task {
+
+    public:
+    struct promise_type : async_detail::promise_base<T> {
+        std::optional<T> value;
+
+        [[nodiscard]] async_task get_return_object ( ) noexcept { return async_task ( handle_t::from_promise ( *this ) ); }
+        void return_value ( T value_ ) { value.emplace ( std::move ( value_ ) ); }
+
+        [[nodiscard]] T result ( ) {
+            if ( this->error )
+                std::rethrow_exception ( this->error );
+            return std::move ( *value );
+        }
+    };
+
+    using handle_t = std::coroutine_handle<promise_type>;
+
+    async_task ( async_task && t_ ) noexcept : _handle ( std::exchange ( t_._handle, nullptr ) ) {}
+    async_task ( const async_task & ) = delete;
+
+    async_task & operator= ( async_task && ) = delete;
+    async_task & operator= ( const async_task & ) = delete;
+
+    ~async_task ( ) {
+        if ( _handle )
+            _handle.destroy ( );
+    }
+
+    [[nodiscard]] bool await_ready ( ) const noexcept { return false; }
+    [[nodiscard]] std::coroutine_handle<> await_suspend ( const std::coroutine_handle<> continuation_ ) noexcept {
+        _handle.promise ( ).continuation = continuation_;
+        return _handle;
+    }
+    T await_resume ( ) { return _handle.promise ( ).result ( ); }
+
+    // Runs the task, blocking the calling thread until it has finished, and
+    // returns its result.
+    friend T sync_wait ( async_task task_ ) {
+        task_._handle.resume ( );
+        task_._handle.promise ( ).done.wait ( false, std::memory_order_acquire );
+        return task_._handle.promise ( ).result ( );
+    }
+
+    private:
+    handle_t _handle;
+
+    explicit async_task ( const handle_t handle_ ) noexcept : _handle ( handle_ ) {}
+};
+
+template<>
+struct async_task<void>::promise_type : async_detail::promise_base<void> {
+    [[nodiscard]] async_task get_return_object ( ) noexcept { return async_task ( handle_t::from_promise ( *this ) ); }
+    void return_void ( ) const noexcept {}
+
+    void result ( ) const {
+        if ( error )
+            std::rethrow_exception ( error );
+    }
+};
+
+// Blocks of an engine (GMPRng2, jsf64, ...) produced ahead on an executor and
+// delivered to coroutines:
+//
+//     auto block = co_await source.next_block ( );
+//
+// resumes with a block as soon as one is ready, without blocking the thread of
+// the awaiting coroutine. At most depth_ blocks exist at any time, ready or
+// held by a consumer; a block goes back to the producer when its handle is
+// destroyed. The producer fills one block per task, so resumptions, which are
+// posted to the resume executor (the producer by default), interleave with it.
+// Blocks are handed out in the order the engine produced them.
+//
+// The engine and the buffers live in a state shared by the source, the
+// producer's tasks and the blocks, so destroying the source never waits for
+// the producer: it may run anywhere, on the producer executor's own thread
+// too, and blocks may outlive it. No coroutine may still be waiting then.
+//
+// An async_task consuming blocks, run with sync_wait:
+//
+//     async_task<std::uint64_t> sum ( auto & source_, std::size_t n_ ) {
+//         std::uint64_t s = 0;
+//         while ( n_-- ) {
+//             const auto block = co_await source_.next_block ( );
+//             for ( const auto v : block )
+//                 s += v;
+//         }
+//         co_return s;
+//     }
+//
+//     const std::uint64_t s = sync_wait ( sum ( source, 1'000 ) );
+template<typename Engine, std::size_t BlockSize = 512, typename Executor = thread_executor>
+class async_block_source {
+
+    struct state_t;
+
+    public:
+    using result_type = typename Engine::result_type;
+    using buffer_type = std::array<result_type, BlockSize>;
+
+    class block {
+        friend class async_block_source;
+
+        std::shared_ptr<state_t> _state;
+        buffer_type * _buffer = nullptr;
+
+        block ( std::shared_ptr<state_t> state_, buffer_type * buffer_ ) noexcept : _state ( std::move ( state_ ) ), _buffer ( buffer_ ) {}
+
+        public:
+        block ( ) noexcept = default;
+        block ( block && b_ ) noexcept : _state ( std::move ( b_._state ) ), _buffer ( std::exchange ( b_._buffer, nullptr ) ) {}
+        block & operator= ( block && b_ ) noexcept {
+            reset ( );
+            _state  = std::move ( b_._state );
+            _buffer = std::exchange ( b_._buffer, nullptr );
+            return *this;
+        }
+        ~block ( ) noexcept { reset ( ); }
+
+        void reset ( ) noexcept {
+            if ( _state )
+                _state->release ( std::exchange ( _buffer, nullptr ) );
+            _state.reset ( );
+        }
+
+        [[nodiscard]] std::span<const result_type, BlockSize> values ( ) const noexcept { return *_buffer; }
+        [[nodiscard]] const result_type * begin ( ) const noexcept { return _buffer->data ( ); }
+        [[nodiscard]] const result_type * end ( ) const noexcept { return _buffer->data ( ) + BlockSize; }
+        [[nodiscard]] static constexpr std::size_t size ( ) noexcept { return BlockSize; }
+        [[nodiscard]] result_type operator[] ( const std::size_t i_ ) const noexcept { return ( *_buffer )[ i_ ]; }
+    };
+
+    class awaiter {
+        friend class async_block_source;
+        friend struct state_t;
+
+        std::shared_ptr<state_t> _state;
+        Executor * _resume_on;
+        buffer_type * _buffer = nullptr;
+
+        awaiter ( std::shared_ptr<state_t> state_, Executor * resume_on_ ) noexcept :
+            _state ( std::move ( state_ ) ), _resume_on ( resume_on_ ) {}
+
+        public:
+        [[nodiscard]] bool await_ready ( ) noexcept { return false; }
+        [[nodiscard]] bool await_suspend ( std::coroutine_handle<> handle_ ) { return _state->take_or_wait ( *this, handle_ ); }
+        [[nodiscard]] block await_resume ( ) noexcept { return { _state, _buffer }; }
+    };
+
+    async_block_source ( Engine engine_, Executor & producer_, const std::size_t depth_ = 4 ) :
+        _state ( std::make_shared<state_t> ( std::move ( engine_ ), producer_, depth_ ) ) {
+        assert ( depth_ );
+        _state->filling = true;
+        producer_.post ( [ s = _state ] { s->produce ( ); } );
+    }
+
+    async_block_source ( async_block_source && )      = delete;
+    async_block_source ( const async_block_source & ) = delete;
+
+    async_block_source & operator= ( async_block_source && ) = delete;
+    async_block_source & operator= ( const async_block_source & ) = delete;
+
+    // Stops the producer, without waiting for it; no coroutine may still be
+    // waiting.
+    ~async_block_source ( ) {
+        std::lock_guard<std::mutex> lock ( _state->mutex );
+        _state->stopping = true;
+        assert ( _state->waiters.empty ( ) );
+    }
+
+    // Resumes on resume_on_, or on the producer if null.
+    [[nodiscard]] awaiter next_block ( Executor * resume_on_ = nullptr ) noexcept { return { _state, resume_on_ }; }
+
+    private:
+    struct waiter_t {
+        awaiter * waiting;
+        std::coroutine_handle<> handle;
+    };
+
+    struct state_t : std::enable_shared_from_this<state_t> {
+        Engine engine;
+        Executor & producer;
+        std::unique_ptr<buffer_type[]> buffers;
+        std::mutex mutex;
+        std::vector<buffer_type *> free;
+        std::deque<buffer_type *> ready;
+        std::deque<waiter_t> waiters;
+        bool filling = false, stopping = false;
+
+        state_t ( Engine engine_, Executor & producer_, const std::size_t depth_ ) :
+            engine ( std::move ( engine_ ) ), producer ( producer_ ), buffers ( std::make_unique<buffer_type[]> ( depth_ ) ) {
+            for ( std::size_t i = 0; i < depth_; ++i )
+                free.push_back ( buffers.get ( ) + i );
+        }
+
+        bool take_or_wait ( awaiter & awaiter_, const std::coroutine_handle<> handle_ ) {
+            std::lock_guard<std::mutex> lock ( mutex );
+            if ( not ready.empty ( ) ) {
+                awaiter_._buffer = ready.front ( );
+                ready.pop_front ( );
+                return false;
+            }
+            waiters.push_back ( { &awaiter_, handle_ } );
+            return true;
+        }
+
+        void release ( buffer_type * buffer_ ) {
+            std::lock_guard<std::mutex> lock ( mutex );
+            free.push_back ( buffer_ );
+            if ( not filling and not stopping ) {
+                filling = true;
+                producer.post ( [ s = this->shared_from_this ( ) ] { s->produce ( ); } );
+            }
+        }
+
+        // Fills one block, hands it to the first waiter or queues it, and
+        // re-posts itself while there are free buffers. Only one produce ( ) is
+        // in flight, so the engine needs no lock.
+        void produce ( ) {
+            buffer_type * buffer;
+            {
+                std::lock_guard<std::mutex> lock ( mutex );
+                if ( free.empty ( ) or stopping ) {
+                    filling = false;
+                    return;
+                }
+                buffer = free.back ( );
+                free.pop_back ( );
+            }
+            fill_block ( engine, buffer->data ( ), buffer->data ( ) + BlockSize );
+            std::lock_guard<std::mutex> lock ( mutex );
+            if ( not waiters.empty ( ) ) {
+                const waiter_t w = waiters.front ( );
+                waiters.pop_front ( );
+                w.waiting->_buffer = buffer;
+                ( w.waiting->_resume_on ? *w.waiting->_resume_on : producer ).post ( [ h = w.handle ] { h.resume ( ); } );
+            }
+            else {
+                ready.push_back ( buffer );
+            }
+            producer.post ( [ s = this->shared_from_this ( ) ] { s->produce ( ); } );
+        }
+    };
+
+    std::shared_ptr<state_t> _state;
+};
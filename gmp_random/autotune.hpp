@@ -0,0 +1,167 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <plf/plf_nanotimer.h>
+
+// A fast embedded battery, meant to rank engine configurations, not to
+// replace PractRand. The counts are cumulative, so checking after every
+// doubling of the stream gives the first failing size (in the spirit of
+// RNG_test's -tlmaxonly) at the cost of the largest size only.
+//
+//   - frequency of the low and of the high byte of each value,
+//   - frequency of pairs of successive low nibbles,
+//   - bias of each bit position.
+
+struct battery_t {
+
+    // |z| above this is a failure, p ~ 1e-10.
+    static constexpr double z_limit = 6.4;
+
+    std::array<std::uint64_t, 256> low_byte{ }, high_byte{ }, low_pair{ };
+    std::array<std::uint64_t, 64> ones{ };
+    std::uint64_t values = 0, previous_nibble = 0;
+    int bits;
+
+    explicit battery_t ( const int bits_ ) noexcept : bits ( bits_ ) {}
+
+    void feed ( const std::uint64_t x_ ) noexcept {
+        ++low_byte[ x_ & 0xff ];
+        ++high_byte[ ( x_ >> ( bits - 8 ) ) & 0xff ];
+        ++low_pair[ ( previous_nibble << 4 ) | ( x_ & 0xf ) ];
+        previous_nibble = x_ & 0xf;
+        for ( int i = 0; i < bits; ++i )
+            ones[ i ] += ( x_ >> i ) & 1;
+        ++values;
+    }
+
+    // Wilson-Hilferty normal approximation of a chi-square statistic.
+    [[nodiscard]] static double chi_square_z ( const std::array<std::uint64_t, 256> & counts_, const std::uint64_t n_ ) noexcept {
+        const double e = n_ / 256.0, k = 255.0;
+        double x       = 0.0;
+        for ( const auto c : counts_ )
+            x += ( c - e ) * ( c - e ) / e;
+        return ( std::cbrt ( x / k ) - ( 1.0 - 2.0 / ( 9.0 * k ) ) ) / std::sqrt ( 2.0 / ( 9.0 * k ) );
+    }
+
+    [[nodiscard]] bool fails ( ) const noexcept {
+        if ( std::abs ( chi_square_z ( low_byte, values ) ) > z_limit or std::abs ( chi_square_z ( high_byte, values ) ) > z_limit or
+             std::abs ( chi_square_z ( low_pair, values ) ) > z_limit )
+            return true;
+        for ( int i = 0; i < bits; ++i )
+            if ( std::abs ( ( ones[ i ] - values / 2.0 ) / std::sqrt ( values / 4.0 ) ) > z_limit )
+                return true;
+        return false;
+    }
+};
+
+// Returns log2 of the size in bytes at which the battery first fails, checked
+// at 2^20 .. 2^max_log2_ bytes, or max_log2_ + 1 if it passes all of them.
+template<typename Engine>
+[[nodiscard]] int first_failure ( const int max_log2_ ) {
+    using result_type        = typename Engine::result_type;
+    constexpr int bits       = 8 * sizeof ( result_type );
+    constexpr int bytes_log2 = sizeof ( result_type ) == 8 ? 3 : sizeof ( result_type ) == 4 ? 2 : sizeof ( result_type ) == 2 ? 1 : 0;
+    Engine rng;
+    battery_t battery ( bits );
+    std::uint64_t n = 0;
+    for ( int log2 = 20; log2 <= max_log2_; ++log2 ) {
+        for ( const std::uint64_t end = std::uint64_t{ 1 } << ( log2 - bytes_log2 ); n < end; ++n )
+            battery.feed ( rng ( ) );
+        if ( battery.fails ( ) )
+            return log2;
+    }
+    return max_log2_ + 1;
+}
+
+// Bytes per second, over bytes_ bytes of output, timed like main ( ).
+template<typename Engine>
+[[nodiscard]] double throughput ( const std::uint64_t bytes_ = std::uint64_t{ 1 } << 28 ) {
+    using result_type = typename Engine::result_type;
+    Engine rng;
+    result_type x = 0;
+    plf::nanotimer timer;
+    timer.start ( );
+    for ( std::uint64_t i = 0, n = bytes_ / sizeof ( result_type ); i < n; ++i )
+        x += rng ( );
+    const double t = timer.get_elapsed_ms ( );
+    volatile result_type sink = x;
+    ( void ) sink;
+    return bytes_ / ( t / 1000.0 );
+}
+
+struct tune_result_t {
+    std::string name;
+    double bytes_per_second;
+    int first_failure;
+    bool pareto = false;
+};
+
+template<typename Engine>
+[[nodiscard]] tune_result_t tune ( std::string name_, const int max_log2_ ) {
+    return { std::move ( name_ ), throughput<Engine> ( ), first_failure<Engine> ( max_log2_ ) };
+}
+
+// Marks the results no other result beats on both throughput and quality, and
+// returns the index of the recommended default: the fastest of the best quality.
+inline std::size_t pareto_frontier ( std::vector<tune_result_t> & results_ ) {
+    for ( auto & r : results_ )
+        r.pareto = std::none_of ( results_.begin ( ), results_.end ( ), [ &r ]( const tune_result_t & o ) {
+            return o.bytes_per_second >= r.bytes_per_second and o.first_failure >= r.first_failure and
+                   ( o.bytes_per_second > r.bytes_per_second or o.first_failure > r.first_failure );
+        } );
+    return std::max_element ( results_.begin ( ), results_.end ( ),
+                              []( const tune_result_t & a, const tune_result_t & b ) {
+                                  return a.first_failure < b.first_failure or
+                                         ( a.first_failure == b.first_failure and a.bytes_per_second < b.bytes_per_second );
+                              } ) -
+           results_.begin ( );
+}
+
+inline void print_tune_results ( std::ostream & out_, const std::vector<tune_result_t> & results_, const int max_log2_ ) {
+    for ( const auto & r : results_ ) {
+        out_ << ( r.pareto ? "* " : "  " ) << r.name << std::string ( r.name.size ( ) < 24 ? 24 - r.name.size ( ) : 1, ' ' )
+             << r.bytes_per_second / ( 1024.0 * 1024.0 * 1024.0 ) << " GB/s  ";
+        if ( r.first_failure > max_log2_ )
+            out_ << "passes 2^" << max_log2_ << " bytes\n";
+        else
+            out_ << "fails at 2^" << r.first_failure << " bytes\n";
+    }
+}
+
+// Writes tuned_generator.hpp.
+inline void emit_tuned_generator ( std::ostream & out_, const tune_result_t & result_, const int max_log2_ ) {
+    out_ << "// Generated by `gmp_random autotune " << max_log2_ << "`, do not edit.\n\n#pragma once\n\nusing tuned_generator = "
+         << result_.name << ";\n";
+}
@@ -0,0 +1,89 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+#include "block.hpp"
+
+// Packed Bernoulli ( p ) bits.
+//
+// Bit i is 1 if U_i < p, U_i uniform in [ 0, 1 ), and U_i compares with p bit
+// by bit from the top, decided at the first bit where they differ ( U_i < p
+// if that's a 0 in U_i and a 1 in p ). One engine word supplies the next bit
+// of U_i for 64 i at once, so a word of output takes the words up to where all
+// 64 comparisons are decided, about log2 64 + 1.3, or up to where the rest of
+// p is 0, instead of a draw per bit. p is taken to precision_ bits, floor ( p
+// 2^precision_ ) 2^-precision_, exactly. Group words go through the bits
+// together, in loops the compiler vectorizes, stopping when all of them are
+// decided.
+
+namespace bernoulli_detail {
+
+// out_ [ 0, N ), p_ the bits of p from the top.
+template<std::size_t N, typename Source>
+void decide ( Source & source_, const std::uint64_t p_, const int precision_, std::uint64_t * const out_ ) {
+    std::array<std::uint64_t, N> one{ }, undecided;
+    undecided.fill ( ~std::uint64_t{ 0 } );
+    for ( int k = 0; k < precision_ and p_ << k; ++k ) {
+        const std::uint64_t * const r = source_.take ( N );
+        const std::uint64_t bit       = std::uint64_t{ 0 } - ( p_ >> ( 63 - k ) & 1 );
+        std::uint64_t any             = 0;
+        for ( std::size_t i = 0; i < N; ++i ) {
+            one[ i ] |= undecided[ i ] & ~r[ i ] & bit;
+            undecided[ i ] &= ~( r[ i ] ^ bit );
+            any |= undecided[ i ];
+        }
+        if ( not any )
+            break;
+    }
+    std::copy_n ( one.data ( ), N, out_ );
+}
+
+} // namespace bernoulli_detail
+
+// Fills out_ with bits that are 1 with probability p_, in [ 0, 1 ], to
+// precision_ bits, in [ 1, 64 ].
+template<std::size_t Group = 8, typename Engine>
+void bernoulli_bits ( Engine & engine_, const double p_, const std::span<std::uint64_t> out_, const int precision_ = 64 ) {
+    static_assert ( sizeof ( typename Engine::result_type ) == sizeof ( std::uint64_t ), "the engine has to produce 64-bit words" );
+    assert ( p_ >= 0.0 and p_ <= 1.0 and precision_ > 0 and precision_ <= 64 );
+    if ( p_ >= 1.0 ) {
+        std::fill ( out_.begin ( ), out_.end ( ), ~std::uint64_t{ 0 } );
+        return;
+    }
+    const std::uint64_t p = std::uint64_t ( p_ * 0x1p64 ) & ~std::uint64_t{ 0 } << ( 64 - precision_ );
+    block_buffer<Engine> source ( engine_ );
+    std::size_t i = 0;
+    for ( ; i + Group <= out_.size ( ); i += Group )
+        bernoulli_detail::decide<Group> ( source, p, precision_, out_.data ( ) + i );
+    for ( ; i < out_.size ( ); ++i )
+        bernoulli_detail::decide<1> ( source, p, precision_, out_.data ( ) + i );
+}
@@ -0,0 +1,125 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+#include "streaming.hpp"
+
+// The block (bulk) interface of the engines.
+//
+// An engine with a generate ( first, last ) member fills a whole block in one
+// call, keeping its state in registers (jsf) or copying limb runs straight out
+// of its state (GMPRng2). fill_block falls back to calling the engine per value
+// for engines without one.
+//
+// With the nontemporal hint, for buffers larger than the last level cache,
+// values are generated into a small staging block that stays in L1 and
+// streamed from there into the aligned interior of the destination; the
+// unaligned edges are filled directly. The values are the same as without.
+
+template<typename Engine>
+void fill_block ( Engine & e_, typename Engine::result_type * first_, typename Engine::result_type * const last_ ) {
+    if constexpr ( requires { e_.generate ( first_, last_ ); } ) {
+        e_.generate ( first_, last_ );
+    }
+    else {
+        for ( ; first_ != last_; ++first_ )
+            *first_ = e_ ( );
+    }
+}
+
+template<typename Engine>
+void fill_block ( Engine & e_, const std::span<typename Engine::result_type> block_ ) {
+    fill_block ( e_, block_.data ( ), block_.data ( ) + block_.size ( ) );
+}
+
+// An engine's values, drawn BlockSize at a time through fill_block and handed
+// out one, or n_ <= BlockSize, at a time. It's an engine itself, for the
+// distributions that take a variable number of values per result.
+template<typename Engine, std::size_t BlockSize = 256>
+class block_buffer {
+    public:
+    using result_type = typename Engine::result_type;
+
+    [[nodiscard]] static constexpr result_type min ( ) noexcept { return Engine::min ( ); }
+    [[nodiscard]] static constexpr result_type max ( ) noexcept { return Engine::max ( ); }
+
+    explicit block_buffer ( Engine & engine_ ) noexcept : _engine ( &engine_ ) {}
+
+    [[nodiscard]] result_type operator( ) ( ) { return *take ( 1 ); }
+
+    // The next n_ values, valid until the next call; if fewer than n_ are
+    // left in the block, they are dropped.
+    [[nodiscard]] const result_type * take ( const std::size_t n_ ) {
+        if ( _index + n_ > BlockSize ) {
+            fill_block ( *_engine, _block.data ( ), _block.data ( ) + BlockSize );
+            _index = 0;
+        }
+        _index += n_;
+        return _block.data ( ) + _index - n_;
+    }
+
+    private:
+    Engine * _engine;
+    std::size_t _index = BlockSize;
+    std::array<result_type, BlockSize> _block;
+};
+
+struct nontemporal_t {
+    explicit nontemporal_t ( ) = default;
+};
+inline constexpr nontemporal_t nontemporal{ };
+
+template<typename Engine>
+void fill_block ( Engine & e_, typename Engine::result_type * first_, typename Engine::result_type * const last_, nontemporal_t ) {
+    using result_type                  = typename Engine::result_type;
+    constexpr std::size_t staging_size = 4'096 / sizeof ( result_type );
+    constexpr std::ptrdiff_t tile      = stream_alignment / sizeof ( result_type );
+    static_assert ( stream_alignment % sizeof ( result_type ) == 0, "values have to tile the stream alignment" );
+    const std::uintptr_t a   = reinterpret_cast<std::uintptr_t> ( first_ );
+    result_type * const body = std::min (
+        reinterpret_cast<result_type *> ( ( a + stream_alignment - 1 ) & ~std::uintptr_t{ stream_alignment - 1 } ), last_ );
+    result_type * const end = body + ( last_ - body ) / tile * tile;
+    fill_block ( e_, first_, body );
+    alignas ( 64 ) result_type staging[ staging_size ];
+    for ( result_type * p = body; p != end; ) {
+        const std::size_t n = std::min<std::size_t> ( staging_size, end - p );
+        fill_block ( e_, staging, staging + n );
+        stream_copy ( p, staging, n * sizeof ( result_type ) );
+        p += n;
+    }
+    stream_fence ( );
+    fill_block ( e_, end, last_ );
+}
+
+template<typename Engine>
+void fill_block ( Engine & e_, const std::span<typename Engine::result_type> block_, const nontemporal_t nontemporal_ ) {
+    fill_block ( e_, block_.data ( ), block_.data ( ) + block_.size ( ), nontemporal_ );
+}
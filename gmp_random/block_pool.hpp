@@ -0,0 +1,133 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "block_ring.hpp"
+
+// An in-process pool of pre-generated blocks for the tasks of a thread pool:
+// background producers, one per engine, keep a block_ring topped up, and a
+// consumer claims a whole block with a single compare-and-swap, instead of
+// every thread owning (and seeding) an engine of its own.
+//
+// Consumers are registered, and each counts its own claims in a cache line of
+// its own (a plain store, it is the only writer); claims ( ) reports them per
+// consumer, for auditing.
+template<typename Engine>
+class block_pool {
+
+    struct alignas ( 64 ) claim_counter_t {
+        std::atomic<std::uint64_t> claims{ 0 };
+    };
+
+    public:
+    class consumer {
+        friend class block_pool;
+
+        block_pool * _pool;
+        claim_counter_t * _counter;
+        std::size_t _id;
+
+        consumer ( block_pool * pool_, claim_counter_t * counter_, const std::size_t id_ ) noexcept :
+            _pool ( pool_ ), _counter ( counter_ ), _id ( id_ ) {}
+
+        void count ( ) noexcept {
+            _counter->claims.store ( _counter->claims.load ( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+        }
+
+        public:
+        [[nodiscard]] std::size_t id ( ) const noexcept { return _id; }
+        [[nodiscard]] std::uint64_t claims ( ) const noexcept { return _counter->claims.load ( std::memory_order_relaxed ); }
+        [[nodiscard]] std::size_t block_words ( ) const noexcept { return _pool->_ring.block_words ( ); }
+
+        // Copies a block into block_ (block_words ( ) words), false if none is ready.
+        [[nodiscard]] bool try_claim ( std::uint64_t * block_ ) noexcept {
+            if ( not _pool->_ring.try_pop ( block_ ) )
+                return false;
+            count ( );
+            return true;
+        }
+
+        void claim ( std::uint64_t * block_ ) noexcept {
+            while ( not _pool->_ring.try_pop ( block_ ) )
+                std::this_thread::yield ( );
+            count ( );
+        }
+    };
+
+    // slots_ (a power of 2) blocks of block_words_ words.
+    explicit block_pool ( std::vector<Engine> engines_, const std::size_t slots_ = 256, const std::size_t block_words_ = 512 ) :
+        _memory ( ::operator new ( block_ring::bytes ( slots_, block_words_ ), std::align_val_t ( 64 ) ) ),
+        _ring ( block_ring::create ( _memory, slots_, block_words_ ) ), _engines ( std::move ( engines_ ) ) {
+        for ( auto & e : _engines )
+            _producers.emplace_back ( [ this, &e ] { produce_blocks ( _ring, e, _stop ); } );
+    }
+
+    block_pool ( block_pool && )      = delete;
+    block_pool ( const block_pool & ) = delete;
+
+    block_pool & operator= ( block_pool && ) = delete;
+    block_pool & operator= ( const block_pool & ) = delete;
+
+    ~block_pool ( ) {
+        _stop.store ( true, std::memory_order_relaxed );
+        for ( auto & t : _producers )
+            t.join ( );
+        ::operator delete ( _memory, std::align_val_t ( 64 ) );
+    }
+
+    [[nodiscard]] consumer make_consumer ( ) {
+        std::lock_guard<std::mutex> lock ( _mutex );
+        return { this, &_counters.emplace_back ( ), _counters.size ( ) - 1 };
+    }
+
+    // The claims of every consumer made so far, indexed by consumer id.
+    [[nodiscard]] std::vector<std::uint64_t> claims ( ) const {
+        std::lock_guard<std::mutex> lock ( _mutex );
+        std::vector<std::uint64_t> c;
+        c.reserve ( _counters.size ( ) );
+        for ( const auto & counter : _counters )
+            c.push_back ( counter.claims.load ( std::memory_order_relaxed ) );
+        return c;
+    }
+
+    private:
+    void * _memory;
+    block_ring _ring;
+    std::vector<Engine> _engines;
+    std::vector<std::thread> _producers;
+    std::atomic<bool> _stop{ false };
+    mutable std::mutex _mutex;
+    std::deque<claim_counter_t> _counters;
+};
@@ -0,0 +1,176 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "block.hpp"
+
+// A bounded multi-producer multi-consumer ring of fixed-size blocks of 64-bit
+// words, over caller-provided memory, which may be shared between processes
+// (the atomics used are lock-free, hence address-free).
+//
+// Every slot carries a sequence number, position + 1 of the last block written
+// to it. A producer claims position p with a compare-and-swap on the enqueue
+// position, while p is less than a ring ahead of the dequeue position, writes
+// the block and publishes it by storing p + 1 in the sequence. A consumer
+// never claims a slot: it copies the block at the dequeue position p out once
+// the sequence reads p + 1, and only then commits with a compare-and-swap of
+// the dequeue position from p to p + 1, dropping the copy if that fails. The
+// slot is free again the moment the dequeue position has moved past it, so a
+// consumer that dies or stalls at any point holds nothing up: every block is
+// still handed out exactly once, and the others carry on. A copy that races a
+// producer overwriting the slot (possible only once p has been taken) is torn,
+// but never committed; the words are copied with relaxed atomics, so the race
+// is benign.
+//
+// create publishes the magic number last (release), attach reads it with
+// acquire, so a ring is only attached to once it is fully built.
+class block_ring {
+
+    public:
+    static constexpr std::uint64_t magic = 0x474d5052'52494e47ULL; // "GMPRRING".
+
+    struct alignas ( 64 ) header_t {
+        std::atomic<std::uint64_t> magic;
+        std::uint64_t slots, block_words, slot_words;
+        alignas ( 64 ) std::atomic<std::uint64_t> enqueue_position;
+        alignas ( 64 ) std::atomic<std::uint64_t> dequeue_position;
+    };
+
+    static_assert ( std::atomic<std::uint64_t>::is_always_lock_free );
+
+    block_ring ( ) noexcept = default;
+
+    // Bytes of memory needed for slots_ (a power of 2) blocks of block_words_ words.
+    [[nodiscard]] static constexpr std::size_t bytes ( const std::size_t slots_, const std::size_t block_words_ ) noexcept {
+        return sizeof ( header_t ) + slots_ * slot_words ( block_words_ ) * sizeof ( std::uint64_t );
+    }
+
+    // Initializes a ring in memory_, which must be 64-byte aligned.
+    [[nodiscard]] static block_ring create ( void * memory_, const std::size_t slots_, const std::size_t block_words_ ) noexcept {
+        assert ( slots_ and not( slots_ & ( slots_ - 1 ) ) );
+        auto * h = new ( memory_ ) header_t{ { 0 }, slots_, block_words_, slot_words ( block_words_ ), { 0 }, { 0 } };
+        block_ring r ( h );
+        for ( std::uint64_t i = 0; i < slots_; ++i )
+            new ( &r.sequence ( i ) ) std::atomic<std::uint64_t> ( i );
+        h->magic.store ( magic, std::memory_order_release );
+        return r;
+    }
+
+    // Attaches to a ring created (possibly by another process) in memory_.
+    [[nodiscard]] static block_ring attach ( void * memory_ ) noexcept {
+        auto * h = static_cast<header_t *> ( memory_ );
+        return block_ring ( ready ( *h ) ? h : nullptr );
+    }
+
+    // Whether the ring of header_ is fully built.
+    [[nodiscard]] static bool ready ( const header_t & header_ ) noexcept {
+        return header_.magic.load ( std::memory_order_acquire ) == magic;
+    }
+
+    [[nodiscard]] explicit operator bool ( ) const noexcept { return _header; }
+    [[nodiscard]] std::size_t block_words ( ) const noexcept { return _header->block_words; }
+    [[nodiscard]] std::size_t slots ( ) const noexcept { return _header->slots; }
+
+    // Copies block_ into the ring, false if it is full.
+    [[nodiscard]] bool try_push ( const std::uint64_t * block_ ) noexcept {
+        std::uint64_t p = _header->enqueue_position.load ( std::memory_order_relaxed );
+        for ( ;; ) {
+            // Acquire: the copies out of the slot's last block happened before its
+            // dequeue was committed.
+            if ( p - _header->dequeue_position.load ( std::memory_order_acquire ) >= _header->slots )
+                return false;
+            if ( _header->enqueue_position.compare_exchange_weak ( p, p + 1, std::memory_order_relaxed ) ) {
+                std::uint64_t * const d = data ( p );
+                for ( std::size_t i = 0, n = _header->block_words; i < n; ++i )
+                    std::atomic_ref<std::uint64_t> ( d[ i ] ).store ( block_[ i ], std::memory_order_relaxed );
+                sequence ( p ).store ( p + 1, std::memory_order_release );
+                return true;
+            }
+        }
+    }
+
+    // Copies the oldest block out of the ring into block_, false if it is empty.
+    [[nodiscard]] bool try_pop ( std::uint64_t * block_ ) noexcept {
+        std::uint64_t p = _header->dequeue_position.load ( std::memory_order_acquire );
+        for ( ;; ) {
+            if ( sequence ( p ).load ( std::memory_order_acquire ) != p + 1 ) {
+                const std::uint64_t q = _header->dequeue_position.load ( std::memory_order_acquire );
+                if ( q == p )
+                    return false;
+                p = q;
+                continue;
+            }
+            std::uint64_t * const d = data ( p );
+            for ( std::size_t i = 0, n = _header->block_words; i < n; ++i )
+                block_[ i ] = std::atomic_ref<std::uint64_t> ( d[ i ] ).load ( std::memory_order_relaxed );
+            if ( _header->dequeue_position.compare_exchange_weak ( p, p + 1, std::memory_order_acq_rel, std::memory_order_acquire ) )
+                return true;
+        }
+    }
+
+    private:
+    header_t * _header = nullptr;
+
+    explicit block_ring ( header_t * header_ ) noexcept : _header ( header_ ) {}
+
+    // A slot is its sequence followed by the block, padded to a cache line.
+    [[nodiscard]] static constexpr std::size_t slot_words ( const std::size_t block_words_ ) noexcept {
+        return ( 1 + block_words_ + 7 ) & ~std::size_t ( 7 );
+    }
+
+    [[nodiscard]] std::uint64_t * slot ( const std::uint64_t position_ ) const noexcept {
+        return reinterpret_cast<std::uint64_t *> ( _header + 1 ) + ( position_ & ( _header->slots - 1 ) ) * _header->slot_words;
+    }
+    [[nodiscard]] std::atomic<std::uint64_t> & sequence ( const std::uint64_t position_ ) const noexcept {
+        return *reinterpret_cast<std::atomic<std::uint64_t> *> ( slot ( position_ ) );
+    }
+    [[nodiscard]] std::uint64_t * data ( const std::uint64_t position_ ) const noexcept { return slot ( position_ ) + 1; }
+};
+
+// The producer loop of the services built on block_ring: fills blocks from
+// engine_ and pushes them, backing off while the ring is full, until stop_.
+template<typename Engine>
+void produce_blocks ( block_ring & ring_, Engine & engine_, const std::atomic<bool> & stop_ ) {
+    static_assert ( sizeof ( typename Engine::result_type ) == sizeof ( std::uint64_t ), "the ring holds 64-bit words" );
+    std::vector<typename Engine::result_type> block ( ring_.block_words ( ) );
+    while ( not stop_.load ( std::memory_order_relaxed ) ) {
+        fill_block ( engine_, block.data ( ), block.data ( ) + block.size ( ) );
+        while ( not ring_.try_push ( reinterpret_cast<const std::uint64_t *> ( block.data ( ) ) ) )
+            if ( stop_.load ( std::memory_order_relaxed ) )
+                return;
+            else
+                std::this_thread::sleep_for ( std::chrono::microseconds ( 100 ) );
+    }
+}
@@ -0,0 +1,120 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "block_ring.hpp"
+#include "shared_memory.hpp"
+
+// A random-block service for the processes of one host. The daemon side,
+// block_service<Engine>, runs one producer thread per engine it owns and
+// publishes blocks into a block_ring in named shared memory; block_client
+// maps the ring and takes blocks out of it with atomics only, no system
+// calls, bar yielding when the ring has run dry. A name already in use, by a
+// live service or one that died without unlinking it, makes the service fail
+// rather than re-initialize the ring under its clients.
+
+template<typename Engine>
+class block_service {
+
+    public:
+    // slots_ (a power of 2) blocks of block_words_ words.
+    block_service ( const char * name_, std::vector<Engine> engines_, const std::size_t slots_ = 1'024,
+                    const std::size_t block_words_ = 512 ) :
+        _name ( name_ ),
+        _mapping ( name_, block_ring::bytes ( slots_, block_words_ ), shared_mapping_t::mode::create ), _engines ( std::move ( engines_ ) ) {
+        if ( not _mapping )
+            return;
+        _ring = block_ring::create ( _mapping.data ( ), slots_, block_words_ );
+        for ( auto & e : _engines )
+            _producers.emplace_back ( [ this, &e ] { produce_blocks ( _ring, e, _stop ); } );
+    }
+
+    block_service ( block_service && )      = delete;
+    block_service ( const block_service & ) = delete;
+
+    block_service & operator= ( block_service && ) = delete;
+    block_service & operator= ( const block_service & ) = delete;
+
+    ~block_service ( ) {
+        _stop.store ( true, std::memory_order_relaxed );
+        for ( auto & t : _producers )
+            t.join ( );
+        if ( _mapping )
+            shared_mapping_t::unlink ( _name.c_str ( ) );
+    }
+
+    [[nodiscard]] explicit operator bool ( ) const noexcept { return bool ( _ring ); }
+
+    private:
+    std::string _name;
+    shared_mapping_t _mapping;
+    block_ring _ring;
+    std::vector<Engine> _engines;
+    std::vector<std::thread> _producers;
+    std::atomic<bool> _stop{ false };
+};
+
+class block_client {
+
+    public:
+    explicit block_client ( const char * name_ ) {
+        // Map the header to learn the size, then the whole ring.
+        const shared_mapping_t header ( name_, sizeof ( block_ring::header_t ), shared_mapping_t::mode::read_only );
+        if ( not header )
+            return;
+        const auto * h = static_cast<const block_ring::header_t *> ( header.data ( ) );
+        if ( not block_ring::ready ( *h ) )
+            return;
+        _mapping = std::make_unique<shared_mapping_t> ( name_, block_ring::bytes ( h->slots, h->block_words ),
+                                                        shared_mapping_t::mode::read_write );
+        if ( *_mapping )
+            _ring = block_ring::attach ( _mapping->data ( ) );
+    }
+
+    [[nodiscard]] explicit operator bool ( ) const noexcept { return bool ( _ring ); }
+    [[nodiscard]] std::size_t block_words ( ) const noexcept { return _ring.block_words ( ); }
+
+    // Copies the next block into block_ (block_words ( ) words), false if
+    // none is ready.
+    [[nodiscard]] bool try_read ( std::uint64_t * block_ ) noexcept { return _ring.try_pop ( block_ ); }
+
+    void read ( std::uint64_t * block_ ) noexcept {
+        while ( not _ring.try_pop ( block_ ) )
+            std::this_thread::yield ( );
+    }
+
+    private:
+    std::unique_ptr<shared_mapping_t> _mapping;
+    block_ring _ring;
+};
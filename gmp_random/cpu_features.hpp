@@ -0,0 +1,117 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+
+#if defined( __x86_64__ ) or defined( _M_X64 ) or defined( __i386__ ) or defined( _M_IX86 )
+#    define GMP_RANDOM_X86 1
+#    if defined( _MSC_VER )
+#        include <intrin.h>
+#    else
+#        include <cpuid.h>
+#    endif
+#    include <immintrin.h>
+#endif
+
+// GMP_RANDOM_TARGET ( "isa,..." ) compiles one function for instructions the
+// build as a whole doesn't assume, it's only called after checking
+// cpu_features::host ( ). MSVC compiles intrinsics without it.
+#if defined( _MSC_VER ) and not defined( __clang__ )
+#    define GMP_RANDOM_TARGET( isa )
+#else
+#    define GMP_RANDOM_TARGET( isa ) __attribute__ ( ( target ( isa ) ) )
+#endif
+
+// GMP_RANDOM_X86_ONLY ( f ) names a kernel variant that only exists on x86,
+// elsewhere its features never are.
+#if defined( GMP_RANDOM_X86 )
+#    define GMP_RANDOM_X86_ONLY( f ) f
+#else
+#    define GMP_RANDOM_X86_ONLY( f ) nullptr
+#endif
+
+// What the host CPU (and OS, for the AVX register state) supports, detected
+// once with cpuid.
+struct cpu_features {
+    bool sse2 = false, pclmul = false, avx = false, avx2 = false, bmi2 = false, adx = false, avx512f = false, avx512dq = false,
+         vpclmulqdq = false;
+
+    [[nodiscard]] static const cpu_features & host ( ) noexcept {
+        static const cpu_features features = detect ( );
+        return features;
+    }
+
+    private:
+    [[nodiscard]] static cpu_features detect ( ) noexcept {
+        cpu_features f;
+#if defined( GMP_RANDOM_X86 )
+        std::uint32_t r[ 4 ];
+        cpuid ( 0, r );
+        const std::uint32_t max_leaf = r[ 0 ];
+        cpuid ( 1, r );
+        f.sse2                   = r[ 3 ] >> 26 & 1;
+        f.pclmul                 = r[ 2 ] >> 1 & 1;
+        const bool osxsave       = r[ 2 ] >> 27 & 1;
+        const std::uint64_t xcr0 = osxsave ? xgetbv ( ) : 0;
+        const bool ymm           = ( xcr0 & 0x06 ) == 0x06;
+        const bool zmm           = ( xcr0 & 0xe6 ) == 0xe6;
+        f.avx                    = ymm and r[ 2 ] >> 28 & 1;
+        if ( max_leaf >= 7 ) {
+            cpuid ( 7, r );
+            f.avx2       = f.avx and r[ 1 ] >> 5 & 1;
+            f.bmi2       = r[ 1 ] >> 8 & 1;
+            f.adx        = r[ 1 ] >> 19 & 1;
+            f.avx512f    = zmm and r[ 1 ] >> 16 & 1;
+            f.avx512dq   = f.avx512f and r[ 1 ] >> 17 & 1;
+            f.vpclmulqdq = f.avx and r[ 2 ] >> 10 & 1;
+        }
+#endif
+        return f;
+    }
+
+#if defined( GMP_RANDOM_X86 )
+    static void cpuid ( const int leaf_, std::uint32_t ( &r_ )[ 4 ] ) noexcept {
+#    if defined( _MSC_VER )
+        int r[ 4 ];
+        __cpuidex ( r, leaf_, 0 );
+        for ( int i = 0; i < 4; ++i )
+            r_[ i ] = std::uint32_t ( r[ i ] );
+#    else
+        __cpuid_count ( leaf_, 0, r_[ 0 ], r_[ 1 ], r_[ 2 ], r_[ 3 ] );
+#    endif
+    }
+
+    [[nodiscard]] static std::uint64_t xgetbv ( ) noexcept {
+#    if defined( _MSC_VER )
+        return _xgetbv ( 0 );
+#    else
+        std::uint32_t a, d;
+        __asm__ ( "xgetbv" : "=a"( a ), "=d"( d ) : "c"( 0 ) );
+        return a | std::uint64_t{ d } << 32;
+#    endif
+    }
+#endif
+};
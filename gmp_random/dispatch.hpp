@@ -0,0 +1,156 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cpu_features.hpp"
+
+// Runtime dispatch of the SIMD kernels, through function pointers (which MSVC
+// has, unlike GNU ifunc).
+//
+// A kernel_slot holds the variants of one kernel, best first, the portable
+// one last, and resolves once, on first use, to the best one the host
+// supports. A forced variant name (dispatch::force, or the GMP_RANDOM_FORCE
+// environment variable at startup) makes every slot that has a supported
+// variant of that name use it instead, so each path can be run, and compared,
+// on one machine; dispatch::force re-resolves the slots already in use.
+
+template<typename Function>
+struct kernel_variant {
+    const char * name;
+    bool ( *supported ) ( const cpu_features & );
+    Function function;
+};
+
+struct kernel_slot_base {
+    std::string name;
+
+    explicit kernel_slot_base ( std::string name_ ) noexcept : name ( std::move ( name_ ) ) {}
+    virtual ~kernel_slot_base ( ) = default;
+
+    virtual void resolve ( const char * forced_ ) noexcept = 0;
+    virtual void print ( std::ostream & out_, const cpu_features & ) const = 0;
+};
+
+struct dispatch {
+
+    // Forces variant name_ where supported, nullptr goes back to the best.
+    static void force ( const char * name_ ) {
+        auto & r = registry ( );
+        std::lock_guard<std::mutex> lock ( r.mutex );
+        r.forced = name_ ? name_ : "";
+        for ( auto * s : r.slots )
+            s->resolve ( forced_name ( r ) );
+    }
+
+    static void print ( std::ostream & out_ ) {
+        auto & r = registry ( );
+        std::lock_guard<std::mutex> lock ( r.mutex );
+        for ( const auto * s : r.slots )
+            s->print ( out_, cpu_features::host ( ) );
+    }
+
+    static void add ( kernel_slot_base * slot_ ) {
+        auto & r = registry ( );
+        std::lock_guard<std::mutex> lock ( r.mutex );
+        r.slots.push_back ( slot_ );
+        slot_->resolve ( forced_name ( r ) );
+    }
+
+    private:
+    struct registry_t {
+        std::mutex mutex;
+        std::vector<kernel_slot_base *> slots;
+        std::string forced;
+
+        registry_t ( ) {
+            if ( const char * env = std::getenv ( "GMP_RANDOM_FORCE" ) )
+                forced = env;
+        }
+    };
+
+    [[nodiscard]] static registry_t & registry ( ) noexcept {
+        static registry_t r;
+        return r;
+    }
+
+    [[nodiscard]] static const char * forced_name ( const registry_t & r_ ) noexcept {
+        return r_.forced.empty ( ) ? nullptr : r_.forced.c_str ( );
+    }
+};
+
+template<typename Function, std::size_t N>
+struct kernel_slot final : kernel_slot_base {
+
+    static_assert ( N > 0, "a kernel needs a (portable) variant" );
+
+    std::array<kernel_variant<Function>, N> variants;
+    std::atomic<Function> selected;
+
+    kernel_slot ( std::string name_, const std::array<kernel_variant<Function>, N> & variants_ ) :
+        kernel_slot_base ( std::move ( name_ ) ), variants ( variants_ ), selected ( variants_.back ( ).function ) {
+        dispatch::add ( this );
+    }
+
+    [[nodiscard]] Function get ( ) const noexcept { return selected.load ( std::memory_order_relaxed ); }
+
+    void resolve ( const char * forced_ ) noexcept override {
+        selected.store ( choose ( forced_ ).function, std::memory_order_relaxed );
+    }
+
+    void print ( std::ostream & out_, const cpu_features & cpu_ ) const override {
+        out_ << name << ':';
+        for ( const auto & v : variants )
+            out_ << ' ' << ( v.function == get ( ) ? "*" : "" ) << v.name << ( v.supported ( cpu_ ) ? "" : "(n/a)" );
+        out_ << '\n';
+    }
+
+    private:
+    [[nodiscard]] const kernel_variant<Function> & choose ( const char * forced_ ) const noexcept {
+        const cpu_features & cpu = cpu_features::host ( );
+        if ( forced_ )
+            for ( const auto & v : variants )
+                if ( not std::strcmp ( v.name, forced_ ) and v.supported ( cpu ) )
+                    return v;
+        for ( const auto & v : variants )
+            if ( v.supported ( cpu ) )
+                return v;
+        return variants.back ( );
+    }
+};
+
+// For the portable variants.
+[[nodiscard]] inline bool always_supported ( const cpu_features & ) noexcept { return true; }
@@ -0,0 +1,209 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <execution>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "block.hpp"
+#include "parallel_generate.hpp"
+
+// Sparse Bernoulli processes by geometric skips.
+//
+// In a run of independent trials that succeed with probability p, the number
+// of failures before the next success is geometric, floor ( log u / log ( 1 -
+// p ) ) for u uniform in ( 0, 1 ], so the successes can be drawn directly, one
+// engine value each, where a draw per trial takes 1 / p of them per success.
+// geometric_skip draws the values BlockSize at a time through the block
+// interface and converts the whole block in one loop.
+
+template<typename Engine, std::size_t BlockSize = 256>
+class geometric_skip {
+
+    using engine_result_type = typename Engine::result_type;
+
+    static constexpr int digits = std::numeric_limits<engine_result_type>::digits;
+
+    public:
+    using result_type = std::uint64_t;
+
+    // The skip when p is 0.
+    static constexpr result_type never = std::numeric_limits<result_type>::max ( );
+
+    // p_ in [ 0, 1 ].
+    geometric_skip ( Engine & engine_, const double p_ ) noexcept :
+        _engine ( &engine_ ), _scale ( p_ < 1.0 ? 1.0 / std::log1p ( -p_ ) : 0.0 ) {
+        assert ( p_ >= 0.0 and p_ <= 1.0 );
+    }
+
+    // The number of failures before the next success.
+    [[nodiscard]] result_type operator( ) ( ) {
+        if ( _index == BlockSize )
+            refill ( );
+        return _skips[ _index++ ];
+    }
+
+    // Writes the indices of the successes among the trials [ first_, last_ ) to
+    // out_, and returns its end. The trials start afresh at first_ ( they are
+    // memoryless ), the skip that runs past last_ is dropped.
+    template<typename OutputIt>
+    OutputIt successes ( std::uint64_t first_, const std::uint64_t last_, OutputIt out_ ) {
+        for ( result_type s; ( s = operator( ) ( ) ) < last_ - first_; ++first_ ) {
+            first_ += s;
+            *out_++ = first_;
+        }
+        return out_;
+    }
+
+    private:
+    Engine * _engine;
+    double _scale; // 1 / log ( 1 - p ).
+    std::size_t _index = BlockSize;
+    std::array<engine_result_type, BlockSize> _block;
+    std::array<result_type, BlockSize> _skips;
+
+    // x_ to ( 0, 1 ], its top 53 bits.
+    [[nodiscard]] static double uniform ( const engine_result_type x_ ) noexcept {
+        if constexpr ( digits > 53 )
+            return double ( ( x_ >> ( digits - 53 ) ) + 1 ) * 0x1p-53;
+        else
+            return ( double ( x_ ) + 1.0 ) * std::ldexp ( 1.0, -digits );
+    }
+
+    // With p = 0, _scale is -inf, and the skips inf, or nan for u = 1, never.
+    void refill ( ) {
+        fill_block ( *_engine, _block.data ( ), _block.data ( ) + BlockSize );
+        for ( std::size_t i = 0; i < BlockSize; ++i ) {
+            const double s = std::log ( uniform ( _block[ i ] ) ) * _scale;
+            _skips[ i ]    = s < 0x1p64 ? result_type ( s ) : never;
+        }
+        _index = 0;
+    }
+};
+
+namespace rng {
+
+// The trials are split into chunks of trial_chunk_size; chunk k draws its skips
+// from its own engine, seeded with substream k of one draw from the engine (
+// see generate ), so the output doesn't depend on the policy.
+inline constexpr std::uint64_t trial_chunk_size = std::uint64_t{ 1 } << 22;
+
+namespace skip_detail {
+
+// Concatenates, in order, what f_ ( skips, first, last, out ) appends to out for
+// the chunks [ first, last ) of [ 0, trials_ ).
+template<typename T, typename ExecutionPolicy, typename Engine, typename Function>
+[[nodiscard]] std::vector<T> for_each_chunk ( ExecutionPolicy && policy_, const std::uint64_t trials_, const double p_,
+                                              Engine & engine_, Function f_ ) {
+    static_assert ( std::is_constructible_v<Engine, std::uint64_t>, "the engine has to be constructible from a 64-bit seed" );
+    const std::uint64_t key = draw_key ( engine_ );
+    std::vector<std::vector<T>> out ( ( trials_ + trial_chunk_size - 1 ) / trial_chunk_size );
+    std::vector<std::size_t> chunks ( out.size ( ) );
+    std::iota ( chunks.begin ( ), chunks.end ( ), std::size_t{ 0 } );
+    std::for_each ( std::forward<ExecutionPolicy> ( policy_ ), chunks.begin ( ), chunks.end ( ), [ & ]( const std::size_t k ) {
+        Engine engine ( substream_seed ( key, k ) );
+        geometric_skip<Engine> skips ( engine, p_ );
+        f_ ( skips, k * trial_chunk_size, std::min ( trials_, ( k + 1 ) * trial_chunk_size ), out[ k ] );
+    } );
+    std::vector<T> all;
+    all.reserve ( std::accumulate ( out.begin ( ), out.end ( ), std::size_t{ 0 },
+                                    [] ( const std::size_t n_, const std::vector<T> & v_ ) { return n_ + v_.size ( ); } ) );
+    for ( const std::vector<T> & v : out )
+        all.insert ( all.end ( ), v.begin ( ), v.end ( ) );
+    return all;
+}
+
+// The row i of pair k_ = i ( i - 1 ) / 2 + j, j < i.
+[[nodiscard]] inline std::uint64_t row ( const std::uint64_t k_ ) noexcept {
+    std::uint64_t i = std::uint64_t ( ( 1.0 + std::sqrt ( 1.0 + 8.0 * double ( k_ ) ) ) / 2.0 );
+    while ( i * ( i - 1 ) / 2 > k_ )
+        --i;
+    while ( i * ( i + 1 ) / 2 <= k_ )
+        ++i;
+    return i;
+}
+
+} // namespace skip_detail
+
+// The indices, ascending, of the successes among trials_ Bernoulli ( p_ )
+// trials.
+template<typename ExecutionPolicy, typename Engine,
+         typename = std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+[[nodiscard]] std::vector<std::uint64_t> bernoulli_successes ( ExecutionPolicy && policy_, const std::uint64_t trials_, const double p_,
+                                                               Engine & engine_ ) {
+    return skip_detail::for_each_chunk<std::uint64_t> (
+        std::forward<ExecutionPolicy> ( policy_ ), trials_, p_, engine_,
+        [] ( auto & skips_, const std::uint64_t first_, const std::uint64_t last_, std::vector<std::uint64_t> & out_ ) {
+            skips_.successes ( first_, last_, std::back_inserter ( out_ ) );
+        } );
+}
+
+template<typename Engine>
+[[nodiscard]] std::vector<std::uint64_t> bernoulli_successes ( const std::uint64_t trials_, const double p_, Engine & engine_ ) {
+    return bernoulli_successes ( std::execution::seq, trials_, p_, engine_ );
+}
+
+// The edges ( u, v ), u < v, of a G ( n_, p_ ) random graph, each of the n_ (
+// n_ - 1 ) / 2 pairs an edge with probability p_, ordered by v, then u ( pair
+// v ( v - 1 ) / 2 + u ). n_ < 2^32.
+template<typename ExecutionPolicy, typename Engine,
+         typename = std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+[[nodiscard]] std::vector<std::pair<std::uint64_t, std::uint64_t>> gnp_edges ( ExecutionPolicy && policy_, const std::uint64_t n_,
+                                                                               const double p_, Engine & engine_ ) {
+    using edge_t = std::pair<std::uint64_t, std::uint64_t>;
+    assert ( n_ < ( std::uint64_t{ 1 } << 32 ) );
+    return skip_detail::for_each_chunk<edge_t> (
+        std::forward<ExecutionPolicy> ( policy_ ), n_ ? n_ * ( n_ - 1 ) / 2 : 0, p_, engine_,
+        [] ( auto & skips_, std::uint64_t k_, const std::uint64_t last_, std::vector<edge_t> & out_ ) {
+            std::uint64_t v = skip_detail::row ( k_ ), u = k_ - v * ( v - 1 ) / 2;
+            for ( std::uint64_t s; ( s = skips_ ( ) ) < last_ - k_; ++k_, ++u ) {
+                k_ += s;
+                u += s;
+                if ( u >= v ) {
+                    v = skip_detail::row ( k_ );
+                    u = k_ - v * ( v - 1 ) / 2;
+                }
+                out_.emplace_back ( u, v );
+            }
+        } );
+}
+
+template<typename Engine>
+[[nodiscard]] std::vector<std::pair<std::uint64_t, std::uint64_t>> gnp_edges ( const std::uint64_t n_, const double p_, Engine & engine_ ) {
+    return gnp_edges ( std::execution::seq, n_, p_, engine_ );
+}
+
+} // namespace rng
@@ -0,0 +1,266 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+
+#include "dispatch.hpp"
+
+// The GF(2) analogue of GMPRng2: the state is a polynomial over GF(2) of degree
+// below k = 64 Words, multiplied by a short (Used words) multiplier polynomial
+// modulo an irreducible x^k + x^a + x^b + x^c + 1 each step. Carry-less, so
+// the product maps onto PCLMULQDQ (2 words per pair of instructions) or
+// VPCLMULQDQ (4), dispatched at runtime, with a portable fallback. The sparse
+// modulus reduces with shifts and xors.
+//
+// The period is the multiplicative order of the multiplier, a divisor of
+// 2^k - 1. The generator is linear over GF(2), like xorshift, and fails
+// linear complexity and matrix rank tests.
+//
+// Included by main.cpp after GMPRng2, with which it shares seeding and the
+// word store.
+
+namespace gf2_detail {
+
+// The modulus x^( 64 Words ) + sum of x^tap.
+template<std::size_t Words>
+struct modulus;
+template<>
+struct modulus<1> {
+    static constexpr std::array<int, 4> taps{ 4, 3, 1, 0 };
+};
+template<>
+struct modulus<2> {
+    static constexpr std::array<int, 4> taps{ 7, 2, 1, 0 };
+};
+template<>
+struct modulus<4> {
+    static constexpr std::array<int, 4> taps{ 10, 5, 2, 0 };
+};
+template<>
+struct modulus<8> {
+    static constexpr std::array<int, 4> taps{ 8, 5, 2, 0 };
+};
+template<>
+struct modulus<16> {
+    static constexpr std::array<int, 4> taps{ 19, 6, 1, 0 };
+};
+template<>
+struct modulus<32> {
+    static constexpr std::array<int, 4> taps{ 19, 14, 13, 0 };
+};
+
+// r_[ 0, n_ + m_ ) = a_[ 0, n_ ) * b_[ 0, m_ ), carry-less.
+using clmul_kernel = void ( * ) ( const std::uint64_t * a_, std::size_t n_, const std::uint64_t * b_, std::size_t m_,
+                                  std::uint64_t * r_ ) noexcept;
+
+inline void clmul_portable ( const std::uint64_t * a_, const std::size_t n_, const std::uint64_t * b_, const std::size_t m_,
+                             std::uint64_t * r_ ) noexcept {
+    std::fill_n ( r_, n_ + m_, std::uint64_t{ 0 } );
+    for ( std::size_t i = 0; i < n_; ++i ) {
+        for ( std::size_t j = 0; j < m_; ++j ) {
+            const std::uint64_t a = a_[ i ], b = b_[ j ];
+            std::uint64_t low = a & 1 ? b : 0, high = 0;
+            for ( int k = 1; k < 64; ++k ) {
+                const std::uint64_t mask = std::uint64_t{ 0 } - ( a >> k & 1 );
+                low ^= ( b << k ) & mask;
+                high ^= ( b >> ( 64 - k ) ) & mask;
+            }
+            r_[ i + j ] ^= low;
+            r_[ i + j + 1 ] ^= high;
+        }
+    }
+}
+
+#if defined( GMP_RANDOM_X86 )
+// For each pair of words, a_i b_j lands on words i + j and i + j + 1, and
+// a_i+1 b_j on i + j + 1 and i + j + 2; the latter is shifted up a word and
+// its top word carried into the next pair, so that every word of r_ is loaded
+// and stored once per j.
+GMP_RANDOM_TARGET ( "sse2,pclmul" )
+inline void clmul_pclmulqdq ( const std::uint64_t * a_, const std::size_t n_, const std::uint64_t * b_, const std::size_t m_,
+                              std::uint64_t * r_ ) noexcept {
+    std::fill_n ( r_, n_ + m_, std::uint64_t{ 0 } );
+    for ( std::size_t j = 0; j < m_; ++j ) {
+        const __m128i b = _mm_cvtsi64_si128 ( std::int64_t ( b_[ j ] ) );
+        __m128i carry   = _mm_setzero_si128 ( );
+        std::size_t i   = 0;
+        for ( ; i + 2 <= n_; i += 2 ) {
+            const __m128i a  = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( a_ + i ) );
+            const __m128i p0 = _mm_clmulepi64_si128 ( a, b, 0x00 ), p1 = _mm_clmulepi64_si128 ( a, b, 0x01 );
+            __m128i * r      = reinterpret_cast<__m128i *> ( r_ + i + j );
+            const __m128i p  = _mm_xor_si128 ( _mm_xor_si128 ( p0, carry ), _mm_slli_si128 ( p1, 8 ) );
+            _mm_storeu_si128 ( r, _mm_xor_si128 ( _mm_loadu_si128 ( r ), p ) );
+            carry = _mm_srli_si128 ( p1, 8 );
+        }
+        if ( i < n_ )
+            carry = _mm_xor_si128 ( carry, _mm_clmulepi64_si128 ( _mm_cvtsi64_si128 ( std::int64_t ( a_[ i ] ) ), b, 0x00 ) );
+        __m128i * r = reinterpret_cast<__m128i *> ( r_ + i + j );
+        if ( i < n_ )
+            _mm_storeu_si128 ( r, _mm_xor_si128 ( _mm_loadu_si128 ( r ), carry ) );
+        else
+            r_[ i + j ] ^= std::uint64_t ( _mm_cvtsi128_si64 ( carry ) );
+    }
+}
+
+// The same with 4 words at a time, each 128-bit half of the registers
+// multiplying its own word (a_i, a_i+2 and a_i+1, a_i+3). Sizes that aren't
+// a multiple of 4 words go to clmul_pclmulqdq.
+GMP_RANDOM_TARGET ( "avx2,pclmul,vpclmulqdq" )
+inline void clmul_vpclmulqdq ( const std::uint64_t * a_, const std::size_t n_, const std::uint64_t * b_, const std::size_t m_,
+                               std::uint64_t * r_ ) noexcept {
+    if ( n_ % 4 ) {
+        clmul_pclmulqdq ( a_, n_, b_, m_, r_ );
+        return;
+    }
+    std::fill_n ( r_, n_ + m_, std::uint64_t{ 0 } );
+    for ( std::size_t j = 0; j < m_; ++j ) {
+        const __m256i b = _mm256_set1_epi64x ( std::int64_t ( b_[ j ] ) );
+        __m256i carry   = _mm256_setzero_si256 ( ); // In word 0.
+        for ( std::size_t i = 0; i < n_; i += 4 ) {
+            const __m256i a  = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( a_ + i ) );
+            const __m256i p0 = _mm256_clmulepi64_epi128 ( a, b, 0x00 );
+            const __m256i p1 = _mm256_permute4x64_epi64 ( _mm256_clmulepi64_epi128 ( a, b, 0x01 ), 0x93 ); // Up a word, rotated.
+            __m256i * r      = reinterpret_cast<__m256i *> ( r_ + i + j );
+            _mm256_storeu_si256 ( r, _mm256_xor_si256 ( _mm256_loadu_si256 ( r ),
+                                                        _mm256_xor_si256 ( p0, _mm256_blend_epi32 ( p1, carry, 0x03 ) ) ) );
+            carry = p1;
+        }
+        r_[ n_ + j ] ^= std::uint64_t ( _mm256_extract_epi64 ( carry, 0 ) );
+    }
+}
+#endif
+
+[[nodiscard]] inline clmul_kernel clmul ( ) noexcept {
+    static kernel_slot<clmul_kernel, 3> slot (
+        "gf2 clmul", { { { "vpclmulqdq", [ ]( const cpu_features & c_ ) { return c_.vpclmulqdq and c_.avx2 and c_.pclmul; },
+                           GMP_RANDOM_X86_ONLY ( clmul_vpclmulqdq ) },
+                         { "pclmulqdq", [ ]( const cpu_features & c_ ) { return c_.pclmul; },
+                           GMP_RANDOM_X86_ONLY ( clmul_pclmulqdq ) },
+                         { "portable", always_supported, clmul_portable } } } );
+    return slot.get ( );
+}
+
+// Reduces r_[ 0, n_ ) modulo modulus<Words> into r_[ 0, Words ), word by word
+// from the top: x^( 64 t ) = x^( 64 ( t - Words ) ) x^k and x^k = the taps.
+template<std::size_t Words>
+void reduce ( std::uint64_t * r_, const std::size_t n_ ) noexcept {
+    for ( std::size_t t = n_ - 1; t >= Words; ) {
+        const std::uint64_t h = r_[ t ];
+        r_[ t ]               = 0;
+        for ( const int e : modulus<Words>::taps ) {
+            r_[ t - Words ] ^= h << e;
+            if ( e )
+                r_[ t - Words + 1 ] ^= h >> ( 64 - e );
+        }
+        if ( not r_[ t ] ) // Only with Words == 1 can a fold land on t itself.
+            --t;
+    }
+}
+
+// r_ = a_ * b_ mod modulus<Words>, b_ of m_ words.
+template<std::size_t Words>
+void multiply ( const std::uint64_t * a_, const std::uint64_t * b_, const std::size_t m_, std::uint64_t * r_ ) noexcept {
+    std::array<std::uint64_t, 2 * Words> product;
+    clmul ( ) ( a_, Words, b_, m_, product.data ( ) );
+    reduce<Words> ( product.data ( ), Words + m_ );
+    std::copy_n ( product.data ( ), Words, r_ );
+}
+
+} // namespace gf2_detail
+
+template<std::size_t Words, int Used = 1, typename Instrumentation = no_instrumentation>
+struct gf2_lehmer {
+
+    static_assert ( Used > 0 and Used <= int ( Words ), "used has to be in [ 1, Words ]" );
+
+    using result_type = std::uint64_t;
+    [[nodiscard]] static constexpr result_type min ( ) noexcept { return result_type ( 0 ); }
+    [[nodiscard]] static constexpr result_type max ( ) noexcept { return ~result_type ( 0 ); }
+
+    static constexpr int used = Used;
+
+    static_mpz_storage_t<Words> _state;
+    static_mpz_storage_t<Used> _multiplier;
+    std::size_t _word = 0;
+
+    // A random non-zero state and a random multiplier of degree at least 1.
+    gf2_lehmer ( ) noexcept {
+        static_mpz_t state ( _state ), multiplier ( _multiplier );
+        state.randomize ( Rng::gen ( ) );
+        state.make_odd ( );
+        multiplier.randomize ( Rng::gen ( ) );
+        _multiplier[ 0 ] |= 2;
+    }
+
+    void advance ( ) noexcept {
+        Instrumentation::on_refill ( );
+        gf2_detail::multiply<Words> ( _state.data ( ), _multiplier.data ( ), Used, _state.data ( ) );
+        _word = 0;
+    }
+
+    // Advances n_ steps (n_ Words values) at once, the state times the
+    // multiplier to the power n_, by square-and-multiply.
+    void jump ( std::uint64_t n_ ) noexcept {
+        static_mpz_storage_t<Words> power{ }, square{ };
+        power[ 0 ] = 1;
+        std::copy_n ( _multiplier.data ( ), Used, square.data ( ) );
+        for ( ; n_; n_ >>= 1 ) {
+            if ( n_ & 1 )
+                gf2_detail::multiply<Words> ( power.data ( ), square.data ( ), Words, power.data ( ) );
+            gf2_detail::multiply<Words> ( square.data ( ), square.data ( ), Words, square.data ( ) );
+        }
+        gf2_detail::multiply<Words> ( _state.data ( ), power.data ( ), Words, _state.data ( ) );
+    }
+
+    [[nodiscard]] result_type operator( ) ( ) noexcept {
+        Instrumentation::on_value ( sizeof ( result_type ) );
+        if ( _word == Words )
+            advance ( );
+        return _state[ _word++ ];
+    }
+
+    // Fills [ first_, last_ ) with the next values, copying whole word runs out
+    // of the state, the bulk path.
+    void generate ( result_type * first_, result_type * const last_ ) noexcept {
+        Instrumentation::on_block ( ( last_ - first_ ) * sizeof ( result_type ) );
+        while ( first_ != last_ ) {
+            if ( _word == Words )
+                advance ( );
+            const std::size_t n = std::min<std::size_t> ( Words - _word, last_ - first_ );
+            first_              = std::copy_n ( _state.data ( ) + _word, n, first_ );
+            _word += n;
+        }
+    }
+
+    [[nodiscard]] bool operator== ( const gf2_lehmer & rhs_ ) const noexcept {
+        return _state == rhs_._state and _word == rhs_._word;
+    }
+    [[nodiscard]] bool operator!= ( const gf2_lehmer & rhs_ ) const noexcept { return not operator== ( rhs_ ); }
+};
@@ -0,0 +1,249 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "shared_memory.hpp"
+
+// Instrumentation policies, the last template parameter of the engines.
+//
+// no_instrumentation compiles to nothing. counting_instrumentation<Tag> keeps
+// per-thread counters, bumped with relaxed loads and stores (plain movs, no
+// locked instructions), that counters ( ) sums on demand over the live and
+// the exited threads. Engines instantiated with the same Tag share counters.
+
+struct engine_counters_t {
+    std::uint64_t values = 0, bytes = 0, blocks = 0, reseeds = 0, refills = 0;
+
+    engine_counters_t & operator+= ( const engine_counters_t & rhs_ ) noexcept {
+        values += rhs_.values;
+        bytes += rhs_.bytes;
+        blocks += rhs_.blocks;
+        reseeds += rhs_.reseeds;
+        refills += rhs_.refills;
+        return *this;
+    }
+};
+
+struct no_instrumentation {
+    static constexpr bool enabled = false;
+
+    static void on_value ( std::size_t ) noexcept {}
+    static void on_block ( std::size_t ) noexcept {}
+    static void on_reseed ( ) noexcept {}
+    static void on_refill ( ) noexcept {}
+};
+
+template<typename Tag>
+struct counting_instrumentation {
+    static constexpr bool enabled = true;
+
+    static void on_value ( const std::size_t bytes_ ) noexcept {
+        auto & l = local ( );
+        bump ( l.values, 1 );
+        bump ( l.bytes, bytes_ );
+    }
+    static void on_block ( const std::size_t bytes_ ) noexcept {
+        auto & l = local ( );
+        bump ( l.blocks, 1 );
+        bump ( l.bytes, bytes_ );
+    }
+    static void on_reseed ( ) noexcept { bump ( local ( ).reseeds, 1 ); }
+    static void on_refill ( ) noexcept { bump ( local ( ).refills, 1 ); }
+
+    [[nodiscard]] static engine_counters_t counters ( ) noexcept {
+        auto & r = registry ( );
+        std::lock_guard<std::mutex> lock ( r.mutex );
+        engine_counters_t c = r.retired;
+        for ( const auto * l : r.live )
+            c += l->snapshot ( );
+        return c;
+    }
+
+    private:
+    using counter_t = std::atomic<std::uint64_t>;
+
+    static void bump ( counter_t & c_, const std::uint64_t n_ ) noexcept {
+        c_.store ( c_.load ( std::memory_order_relaxed ) + n_, std::memory_order_relaxed );
+    }
+
+    struct local_t;
+
+    struct registry_t {
+        std::mutex mutex;
+        std::vector<const local_t *> live;
+        engine_counters_t retired;
+    };
+
+    struct local_t {
+        counter_t values{ 0 }, bytes{ 0 }, blocks{ 0 }, reseeds{ 0 }, refills{ 0 };
+
+        local_t ( ) {
+            auto & r = registry ( );
+            std::lock_guard<std::mutex> lock ( r.mutex );
+            r.live.push_back ( this );
+        }
+        ~local_t ( ) {
+            auto & r = registry ( );
+            std::lock_guard<std::mutex> lock ( r.mutex );
+            r.retired += snapshot ( );
+            r.live.erase ( std::find ( r.live.begin ( ), r.live.end ( ), this ) );
+        }
+
+        [[nodiscard]] engine_counters_t snapshot ( ) const noexcept {
+            return { values.load ( std::memory_order_relaxed ), bytes.load ( std::memory_order_relaxed ),
+                     blocks.load ( std::memory_order_relaxed ), reseeds.load ( std::memory_order_relaxed ),
+                     refills.load ( std::memory_order_relaxed ) };
+        }
+    };
+
+    [[nodiscard]] static registry_t & registry ( ) noexcept {
+        static registry_t r;
+        return r;
+    }
+    [[nodiscard]] static local_t & local ( ) noexcept {
+        static thread_local local_t l;
+        return l;
+    }
+};
+
+// A named shared-memory page holding the last published counters, for an
+// external process to read. Writes are guarded by a sequence lock; the fields
+// are relaxed atomics, so the reader's racing loads are well defined, and the
+// magic number is stored last, with release.
+struct stats_page_t {
+
+    static constexpr std::uint64_t magic = 0x474d5052'53544154ULL; // "GMPRSTAT".
+
+    struct layout_t {
+        std::atomic<std::uint64_t> magic, sequence, values, bytes, blocks, reseeds, refills;
+    };
+
+    static constexpr std::size_t page_size = 4'096;
+    static_assert ( sizeof ( layout_t ) <= page_size );
+    static_assert ( std::atomic<std::uint64_t>::is_always_lock_free );
+
+    explicit stats_page_t ( const char * name_, const bool create_ = true ) noexcept :
+        _mapping ( name_, page_size, create_ ? shared_mapping_t::mode::create : shared_mapping_t::mode::read_only ),
+        _page ( static_cast<layout_t *> ( _mapping.data ( ) ) ) {
+        if ( _page and create_ ) {
+            new ( _page ) layout_t{ { 0 }, { 0 }, { 0 }, { 0 }, { 0 }, { 0 }, { 0 } };
+            _page->magic.store ( magic, std::memory_order_release );
+        }
+    }
+
+    [[nodiscard]] explicit operator bool ( ) const noexcept { return _page; }
+
+    void publish ( const engine_counters_t & c_ ) noexcept {
+        const std::uint64_t s = _page->sequence.load ( std::memory_order_relaxed );
+        _page->sequence.store ( s + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence ( std::memory_order_release );
+        _page->values.store ( c_.values, std::memory_order_relaxed );
+        _page->bytes.store ( c_.bytes, std::memory_order_relaxed );
+        _page->blocks.store ( c_.blocks, std::memory_order_relaxed );
+        _page->reseeds.store ( c_.reseeds, std::memory_order_relaxed );
+        _page->refills.store ( c_.refills, std::memory_order_relaxed );
+        _page->sequence.store ( s + 2, std::memory_order_release );
+    }
+
+    [[nodiscard]] bool read ( engine_counters_t & c_ ) const noexcept {
+        if ( _page->magic.load ( std::memory_order_acquire ) != magic )
+            return false;
+        std::uint64_t s;
+        do {
+            while ( ( s = _page->sequence.load ( std::memory_order_acquire ) ) & 1 )
+                ;
+            c_ = { _page->values.load ( std::memory_order_relaxed ), _page->bytes.load ( std::memory_order_relaxed ),
+                   _page->blocks.load ( std::memory_order_relaxed ), _page->reseeds.load ( std::memory_order_relaxed ),
+                   _page->refills.load ( std::memory_order_relaxed ) };
+            std::atomic_thread_fence ( std::memory_order_acquire );
+        } while ( s != _page->sequence.load ( std::memory_order_relaxed ) );
+        return true;
+    }
+
+    private:
+    shared_mapping_t _mapping;
+    layout_t * _page;
+};
+
+// Publishes Instrumentation::counters ( ) to the stats page name_ every
+// interval_, from a thread of its own, and once more on destruction, which
+// also removes the name.
+template<typename Instrumentation>
+class stats_publisher {
+
+    public:
+    explicit stats_publisher ( const char * name_, const std::chrono::milliseconds interval_ = std::chrono::milliseconds ( 100 ) ) :
+        _name ( name_ ), _page ( name_ ) {
+        if ( not _page )
+            return;
+        _thread = std::thread ( [ this, interval_ ] {
+            std::unique_lock<std::mutex> lock ( _mutex );
+            do
+                _page.publish ( Instrumentation::counters ( ) );
+            while ( not _stopped.wait_for ( lock, interval_, [ this ] { return _stop; } ) );
+        } );
+    }
+
+    stats_publisher ( stats_publisher && )      = delete;
+    stats_publisher ( const stats_publisher & ) = delete;
+
+    stats_publisher & operator= ( stats_publisher && ) = delete;
+    stats_publisher & operator= ( const stats_publisher & ) = delete;
+
+    ~stats_publisher ( ) {
+        if ( not _page )
+            return;
+        {
+            std::lock_guard<std::mutex> lock ( _mutex );
+            _stop = true;
+        }
+        _stopped.notify_one ( );
+        _thread.join ( );
+        _page.publish ( Instrumentation::counters ( ) );
+        shared_mapping_t::unlink ( _name.c_str ( ) );
+    }
+
+    [[nodiscard]] explicit operator bool ( ) const noexcept { return bool ( _page ); }
+
+    private:
+    std::string _name;
+    stats_page_t _page;
+    std::mutex _mutex;
+    std::condition_variable _stopped;
+    bool _stop = false;
+    std::thread _thread;
+};
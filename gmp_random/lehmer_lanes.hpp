@@ -0,0 +1,224 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+#include "dispatch.hpp"
+
+// Lanes independent GMPRng2<S, Used> states advanced in lock-step, the limbs
+// stored transposed in radix 2^32 (digit d of every lane next to each other),
+// so that one AVX2 vpmuludq does 4 of the 32 x 32 -> 64 bit multiplies of the
+// schoolbook product. The low and high halves of the partial products are
+// summed per column in 64-bit accumulators, which can't overflow, and the
+// carry is propagated lazily, once per column. The window kept is the one
+// GMPRng2 keeps, so lane l produces exactly the stream of a GMPRng2 with the same
+// state and multiplier. The output interleaves the lanes limb by limb. The
+// AVX2 step is dispatched at runtime.
+//
+// Included by main.cpp after GMPRng2, with which it shares seeding and the
+// vetted multipliers.
+
+template<std::size_t S, std::size_t Lanes = 8, int Used = 2, typename Instrumentation = no_instrumentation>
+struct lehmer_lanes {
+
+    static_assert ( S % 2 == 0, "size has to be even" );
+    static_assert ( Used > 0 and Used <= int ( S ), "used has to be in [ 1, S ]" );
+    static_assert ( Lanes > 0, "lanes has to be positive" );
+
+    using result_type = std::uint64_t;
+    [[nodiscard]] static constexpr result_type min ( ) noexcept { return result_type ( 0 ); }
+    [[nodiscard]] static constexpr result_type max ( ) noexcept { return ~result_type ( 0 ); }
+
+    static constexpr int used                      = Used;
+    static constexpr std::size_t digits            = 2 * S;
+    static constexpr std::size_t multiplier_digits = 2 * Used;
+    static constexpr std::size_t product_digits    = digits + multiplier_digits;
+    static constexpr std::size_t window            = 2 * ( Used - 1 ); // First product digit kept.
+    static constexpr std::size_t block_size        = S * Lanes;
+    static constexpr std::uint64_t digit_mask      = 0xffff'ffffULL;
+
+    // Digit d of all lanes, each < 2^32.
+    using lane_t = std::array<std::uint64_t, Lanes>;
+
+    alignas ( 32 ) std::array<lane_t, digits> _state;
+    alignas ( 32 ) std::array<lane_t, multiplier_digits> _multiplier;
+    std::size_t _index = 0;
+
+    explicit lehmer_lanes ( const std::size_t multiplier_index_ = 0 ) noexcept {
+        static_mpz_storage_t<S> state;
+        static_mpz_storage_t<Used> multiplier;
+        for ( std::size_t l = 0; l < Lanes; ++l ) {
+            static_mpz_t s ( state );
+            s.randomize ( Rng::gen ( ), S );
+            s.make_odd ( );
+            vetted_multiplier<Used> ( multiplier.data ( ), multiplier_index_ + l );
+            load ( l, state.data ( ), multiplier.data ( ) );
+        }
+    }
+
+    // Sets lane l_ to the S limbs of state_ and the Used limbs of multiplier_.
+    void load ( const std::size_t l_, const mp_limb_t * state_, const mp_limb_t * multiplier_ ) noexcept {
+        for ( std::size_t i = 0; i < S; ++i ) {
+            _state[ 2 * i ][ l_ ]     = state_[ i ] & digit_mask;
+            _state[ 2 * i + 1 ][ l_ ] = state_[ i ] >> 32;
+        }
+        for ( int i = 0; i < Used; ++i ) {
+            _multiplier[ 2 * i ][ l_ ]     = multiplier_[ i ] & digit_mask;
+            _multiplier[ 2 * i + 1 ][ l_ ] = multiplier_[ i ] >> 32;
+        }
+        _index = 0;
+    }
+
+    [[nodiscard]] result_type limb ( const std::size_t i_, const std::size_t l_ ) const noexcept {
+        return _state[ 2 * i_ ][ l_ ] | ( _state[ 2 * i_ + 1 ][ l_ ] << 32 );
+    }
+
+    void advance ( ) noexcept {
+        Instrumentation::on_refill ( );
+        stepper ( ) ( *this );
+        _index = 0;
+    }
+
+    [[nodiscard]] result_type operator( ) ( ) noexcept {
+        Instrumentation::on_value ( sizeof ( result_type ) );
+        if ( _index == block_size )
+            advance ( );
+        const std::size_t i = _index++;
+        return limb ( i / Lanes, i % Lanes );
+    }
+
+    // Fills [ first_, last_ ) with the next values, the bulk path.
+    void generate ( result_type * first_, result_type * const last_ ) noexcept {
+        Instrumentation::on_block ( ( last_ - first_ ) * sizeof ( result_type ) );
+        while ( first_ != last_ ) {
+            if ( _index == block_size )
+                advance ( );
+            // Row t holds limb t of every lane, rows are copied whole where possible.
+            const std::size_t n = std::min<std::size_t> ( block_size - _index, last_ - first_ ), end = _index + n;
+            while ( _index != end ) {
+                const std::size_t t = _index / Lanes, l = _index % Lanes, e = std::min ( Lanes, l + ( end - _index ) );
+                for ( std::size_t i = l; i < e; ++i )
+                    *first_++ = limb ( t, i );
+                _index += e - l;
+            }
+        }
+    }
+
+    [[nodiscard]] bool operator== ( const lehmer_lanes & rhs_ ) const noexcept {
+        return _state == rhs_._state and _index == rhs_._index;
+    }
+    [[nodiscard]] bool operator!= ( const lehmer_lanes & rhs_ ) const noexcept { return not operator== ( rhs_ ); }
+
+    private:
+    using step_kernel = void ( * ) ( lehmer_lanes & ) noexcept;
+
+    [[nodiscard]] static step_kernel stepper ( ) noexcept {
+        if constexpr ( Lanes % 4 == 0 ) {
+            static kernel_slot<step_kernel, 2> slot (
+                "lehmer_lanes<" + std::to_string ( S ) + ", " + std::to_string ( Lanes ) + ", " + std::to_string ( Used ) +
+                    "> step",
+                { { { "avx2", [ ]( const cpu_features & c_ ) { return c_.avx2; }, GMP_RANDOM_X86_ONLY ( step_avx2 ) },
+                    { "portable", always_supported, step } } } );
+            return slot.get ( );
+        }
+        else {
+            return step;
+        }
+    }
+
+    // Product scanning: column k of the product is summed in registers, from the
+    // low halves of its partial products, the high halves of those of column
+    // k - 1 and the carry. Digit k - window is stored one column late, after
+    // column k + 1, the last one to read the old digit there, is done.
+    static void step ( lehmer_lanes & g_ ) noexcept {
+        auto & state      = g_._state;
+        auto & multiplier = g_._multiplier;
+        lane_t carry{ }, high{ }, pending{ }, sum;
+        for ( std::size_t k = 0; k < window + digits; ++k ) {
+            for ( std::size_t l = 0; l < Lanes; ++l )
+                sum[ l ] = carry[ l ] + high[ l ], high[ l ] = 0;
+            for ( std::size_t j = k < digits ? 0 : k - digits + 1, e = std::min ( k, multiplier_digits - 1 ); j <= e; ++j ) {
+                for ( std::size_t l = 0; l < Lanes; ++l ) {
+                    const std::uint64_t p = state[ k - j ][ l ] * multiplier[ j ][ l ];
+                    sum[ l ] += p & digit_mask;
+                    high[ l ] += p >> 32;
+                }
+            }
+            if ( k > window )
+                state[ k - window - 1 ] = pending;
+            for ( std::size_t l = 0; l < Lanes; ++l )
+                pending[ l ] = sum[ l ] & digit_mask, carry[ l ] = sum[ l ] >> 32;
+        }
+        state[ digits - 1 ] = pending;
+    }
+
+#if defined( GMP_RANDOM_X86 )
+    // step ( ), 4 lanes per register, all the registers of a column at once
+    // (independent dependency chains).
+    GMP_RANDOM_TARGET ( "avx2" ) static void step_avx2 ( lehmer_lanes & g_ ) noexcept {
+        constexpr std::size_t groups = Lanes / 4;
+        const __m256i mask           = _mm256_set1_epi64x ( digit_mask );
+        __m256i b[ multiplier_digits ][ groups ];
+        for ( std::size_t j = 0; j < multiplier_digits; ++j )
+            for ( std::size_t g = 0; g < groups; ++g )
+                b[ j ][ g ] = load ( g_._multiplier[ j ], 4 * g );
+        __m256i carry[ groups ], high[ groups ], pending[ groups ], sum[ groups ];
+        for ( std::size_t g = 0; g < groups; ++g )
+            carry[ g ] = _mm256_setzero_si256 ( ), high[ g ] = _mm256_setzero_si256 ( );
+        for ( std::size_t k = 0; k < window + digits; ++k ) {
+            for ( std::size_t g = 0; g < groups; ++g )
+                sum[ g ] = _mm256_add_epi64 ( carry[ g ], high[ g ] ), high[ g ] = _mm256_setzero_si256 ( );
+            for ( std::size_t j = k < digits ? 0 : k - digits + 1, e = std::min ( k, multiplier_digits - 1 ); j <= e; ++j ) {
+                for ( std::size_t g = 0; g < groups; ++g ) {
+                    const __m256i p = _mm256_mul_epu32 ( load ( g_._state[ k - j ], 4 * g ), b[ j ][ g ] );
+                    sum[ g ]        = _mm256_add_epi64 ( sum[ g ], _mm256_and_si256 ( p, mask ) );
+                    high[ g ]       = _mm256_add_epi64 ( high[ g ], _mm256_srli_epi64 ( p, 32 ) );
+                }
+            }
+            for ( std::size_t g = 0; g < groups; ++g ) {
+                if ( k > window )
+                    store ( g_._state[ k - window - 1 ], 4 * g, pending[ g ] );
+                pending[ g ] = _mm256_and_si256 ( sum[ g ], mask );
+                carry[ g ]   = _mm256_srli_epi64 ( sum[ g ], 32 );
+            }
+        }
+        for ( std::size_t g = 0; g < groups; ++g )
+            store ( g_._state[ digits - 1 ], 4 * g, pending[ g ] );
+    }
+
+    [[nodiscard]] GMP_RANDOM_TARGET ( "avx2" ) static __m256i load ( const lane_t & digit_, const std::size_t l_ ) noexcept {
+        return _mm256_load_si256 ( reinterpret_cast<const __m256i *> ( digit_.data ( ) + l_ ) );
+    }
+    GMP_RANDOM_TARGET ( "avx2" ) static void store ( lane_t & digit_, const std::size_t l_, const __m256i x_ ) noexcept {
+        _mm256_store_si256 ( reinterpret_cast<__m256i *> ( digit_.data ( ) + l_ ), x_ );
+    }
+#endif
+};
@@ -25,24 +25,38 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <execution>
 #include <filesystem>
 #include <fstream>
 #include <iterator>
 #include <list>
 #include <map>
+#include <new>
+#include <numeric>
+#include <optional>
 #include <random>
 #include <sax/iostream.hpp>
+#include <span>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <plf/plf_nanotimer.h>
 
+#ifdef _WIN32 // needed to allow binary stdout on windows
+#    include <fcntl.h>
+#    include <io.h>
+#endif
+
+#include "instrumentation.hpp"
+
 #include <sax/prng.hpp>
 #include <sax/singleton.hpp>
 #include <sax/uniform_int_distribution.hpp>
@@ -57,7 +71,8 @@
 
 namespace jsf_detail {
 
-template<typename itype, typename rtype, unsigned int p, unsigned int q, unsigned int r>
+template<typename itype, typename rtype, unsigned int p, unsigned int q, unsigned int r,
+         typename Instrumentation = no_instrumentation>
 class jsf {
     protected:
     itype a_, b_, c_, d_;
@@ -80,6 +95,7 @@ class jsf {
     }
 
     void seed ( const itype seed = itype ( 0xcafe5eed00000001ULL ) ) {
+        Instrumentation::on_reseed ( );
         a_ = 0xf1ea5eed;
         b_ = seed;
         c_ = seed;
@@ -96,11 +112,59 @@ class jsf {
         d_      = e + a_;
     }
 
+    // The inverse of advance ( ), the step is a bijection of the state.
+    void retreat ( ) {
+        const itype e = d_ - a_, d = c_ - e, c = b_ - ( r ? rotate ( d, r ) : d ), b = a_ ^ rotate ( c, q );
+        a_            = e + rotate ( b, p );
+        b_            = b;
+        c_            = c;
+        d_            = d;
+    }
+
     rtype operator( ) ( ) {
+        Instrumentation::on_value ( sizeof ( rtype ) );
         advance ( );
         return rtype ( d_ );
     }
 
+    // Fills [ first_, last_ ) with the next values, the bulk path; the state is
+    // kept in registers for the whole block.
+    void generate ( rtype * first_, rtype * const last_ ) {
+        Instrumentation::on_block ( ( last_ - first_ ) * sizeof ( rtype ) );
+        itype a = a_, b = b_, c = c_, d = d_;
+        for ( ; first_ != last_; ++first_ ) {
+            const itype e = a - rotate ( b, p );
+            a             = b ^ rotate ( c, q );
+            b             = c + ( r ? rotate ( d, r ) : d );
+            c             = d + e;
+            d             = e + a;
+            *first_       = rtype ( d );
+        }
+        a_ = a;
+        b_ = b;
+        c_ = c;
+        d_ = d;
+    }
+
+    // Undoes generate ( first_, last_ ): writes the last_ - first_ values up to
+    // the current state, in their ( forward ) order, and retreats over them.
+    void generate_backward ( rtype * const first_, rtype * last_ ) {
+        Instrumentation::on_block ( ( last_ - first_ ) * sizeof ( rtype ) );
+        itype a = a_, b = b_, c = c_, d = d_;
+        while ( last_ != first_ ) {
+            *--last_      = rtype ( d );
+            const itype e = d - a;
+            d             = c - e;
+            c             = b - ( r ? rotate ( d, r ) : d );
+            b             = a ^ rotate ( c, q );
+            a             = e + rotate ( b, p );
+        }
+        a_ = a;
+        b_ = b;
+        c_ = c;
+        d_ = d;
+    }
+
     bool operator== ( const jsf & rhs ) { return ( a_ == rhs.a_ ) && ( b_ == rhs.b_ ) && ( c_ == rhs.c_ ) && ( d_ == rhs.d_ ); }
 
     bool operator!= ( const jsf & rhs ) { return !operator== ( rhs ); }
@@ -213,6 +277,13 @@ struct Rng final {
 
 #include <gmpxx.h>
 
+#include "multipliers.hpp"
+#include "ntt.hpp"
+#include "parallel_generate.hpp"
+#include "tempering.hpp"
+#include "spectral_test.hpp"
+#include "stream_distance.hpp"
+
 template<std::size_t S>
 using static_mpz_storage_t = std::array<mp_limb_t, S>;
 
@@ -257,6 +328,11 @@ struct static_mpz_t {
         return *this;
     }
 
+    [[nodiscard]] bool operator== ( const static_mpz_t & rhs_ ) const noexcept {
+        return _mp_size == rhs_._mp_size and not mpn_cmp ( _mp_d, rhs_._mp_d, _mp_size );
+    }
+    [[nodiscard]] bool operator!= ( const static_mpz_t & rhs_ ) const noexcept { return not operator== ( rhs_ ); }
+
     [[nodiscard]] constexpr int capacity ( ) noexcept { return _mp_alloc; }
     [[nodiscard]] int size ( ) noexcept { return _mp_size; }
 
@@ -265,8 +341,7 @@ struct static_mpz_t {
         assert ( _mp_d );
         assert ( size_ <= _mp_alloc );
         _mp_size = size_ ? size_ : _mp_alloc;
-        std::generate ( std::execution::par_unseq, _mp_d, _mp_d + _mp_size,
-                        [&]( ) { return sax::uniform_int_distribution<mp_limb_t> ( ) ( gen_ ); } );
+        rng::generate ( std::execution::par_unseq, _mp_d, _mp_d + _mp_size, gen_, sax::uniform_int_distribution<mp_limb_t> ( ) );
     }
 
     void make_odd ( ) noexcept {
@@ -298,22 +373,86 @@ struct static_mpz_t {
     [[nodiscard]] static_mpz_t high_view ( ) noexcept { return { -1, _mp_size / 2, _mp_d + _mp_size / 2 }; }
 };
 
+// mpn_mul_n runs on one core; the NTT product ( ntt.hpp ) spreads its
+// transforms over all of them, but whether and from how many limbs that pays
+// depends on the host ( on one core it's 1.1 - 1.4 times slower than mpn_mul_n
+// at 2^15 - 2^20 limbs ). So big_mul_n only takes it from the limb count in
+// GMP_RANDOM_PARALLEL_MUL, read once; unset or 0, never. gmp_random bench huge
+// times both.
+[[nodiscard]] std::size_t parallel_mul_threshold ( ) noexcept {
+    static const std::size_t threshold = [] {
+        const char * env        = std::getenv ( "GMP_RANDOM_PARALLEL_MUL" );
+        const std::size_t limbs   = env ? std::strtoull ( env, nullptr, 10 ) : 0;
+        return limbs ? limbs : ~std::size_t{ 0 };
+    }( );
+    return threshold;
+}
+
+// d_ [ 0, 2 n_ ) = s1_ s2_, of n_ limbs each. The NTT product allocates its
+// transforms; if that fails, mpn_mul_n does it.
+void big_mul_n ( mp_limb_t * d_, const mp_limb_t * s1_, const mp_limb_t * s2_, const std::size_t n_ ) noexcept {
+    if ( n_ >= parallel_mul_threshold ( ) ) {
+        try {
+            ntt_mul ( d_, s1_, n_, s2_, n_ );
+            return;
+        }
+        catch ( const std::bad_alloc & ) {
+        }
+    }
+    mpn_mul_n ( d_, s1_, s2_, n_ );
+}
+
 void mul ( static_mpz_t & d_, static_mpz_t & s1_, static_mpz_t & s2_ ) noexcept {
     assert ( s1_._mp_size == s2_._mp_size );
     assert ( d_._mp_alloc == 2 * s1_._mp_size );
     d_._mp_size = d_._mp_alloc;
-    mpn_mul_n ( d_._mp_d, s1_._mp_d, s2_._mp_d, s1_._mp_size );
+    big_mul_n ( d_._mp_d, s1_._mp_d, s2_._mp_d, s1_._mp_size );
+}
+
+// Writes the index_'th multiplier of Limbs limbs from multipliers.hpp to m_, or
+// a random odd one if no table of Limbs limbs has been generated.
+template<std::size_t Limbs>
+void vetted_multiplier ( mp_limb_t * m_, const std::size_t index_ ) noexcept {
+    if constexpr ( vetted_multipliers<Limbs>::size ) {
+        std::copy_n ( vetted_multipliers<Limbs>::value[ index_ % vetted_multipliers<Limbs>::size ], Limbs, m_ );
+    }
+    else {
+        static_mpz_t multiplier ( Limbs, 0, m_ );
+        multiplier.randomize ( Rng::gen ( ) );
+        multiplier.make_odd ( );
+    }
 }
 
-/*
+// m_^-1 mod 2^64, m_ odd, with GMP.
+[[nodiscard]] mp_limb_t limb_inverse ( const mp_limb_t m_ ) noexcept {
+    mpz_t m, modulus, inverse;
+    mpz_inits ( m, modulus, inverse, nullptr );
+    mpz_import ( m, 1, -1, sizeof ( mp_limb_t ), 0, 0, &m_ );
+    mpz_setbit ( modulus, GMP_NUMB_BITS );
+    mpz_invert ( inverse, m, modulus );
+    const mp_limb_t r = mpz_getlimbn ( inverse, 0 );
+    mpz_clears ( m, modulus, inverse, nullptr );
+    return r;
+}
 
 namespace lehmer_detail {
 
+// m_^-1 mod 2^( 8 sizeof ( stype ) ), m_ odd: Newton's iteration, from the 3
+// bits m_ m_ = 1 mod 8 gets right, doubles the correct bits each step.
+template<typename stype>
+[[nodiscard]] constexpr stype mcg_inverse ( const stype m_ ) noexcept {
+    stype x = m_;
+    for ( int i = 0; i < 7; ++i )
+        x *= 2 - m_ * x;
+    return x;
+}
+
 template<typename rtype, typename stype>
 class mcg128 {
     stype state_;
     static constexpr __uint128_t MCG_MULT = ( __uint128_t{ 5017888479014934897ULL } << 64 ) +
                                             2747143273072462557ULL; // passing as a template parameter crashes clang frontend.
+    static constexpr stype MCG_INVERSE = mcg_inverse<stype> ( MCG_MULT );
 
     static constexpr unsigned int STYPE_BITS = 8 * sizeof ( stype );
     static constexpr unsigned int RTYPE_BITS = 8 * sizeof ( rtype );
@@ -330,12 +469,35 @@ class mcg128 {
     void seed ( const rtype s_ ) { state_ = stype{ s_ | 1 }; }
 
     void advance ( ) { state_ *= MCG_MULT; }
+    void retreat ( ) { state_ *= MCG_INVERSE; }
+
+    [[nodiscard]] stype state ( ) const noexcept { return state_; }
+    [[nodiscard]] static constexpr stype multiplier ( ) noexcept { return MCG_MULT; }
 
     result_type operator( ) ( ) {
         advance ( );
         return result_type ( state_ >> ( STYPE_BITS - RTYPE_BITS ) );
     }
 
+    void generate ( rtype * first_, rtype * const last_ ) {
+        stype state = state_;
+        for ( ; first_ != last_; ++first_ ) {
+            state *= MCG_MULT;
+            *first_ = rtype ( state >> ( STYPE_BITS - RTYPE_BITS ) );
+        }
+        state_ = state;
+    }
+
+    // Undoes generate ( first_, last_ ), see jsf.
+    void generate_backward ( rtype * const first_, rtype * last_ ) {
+        stype state = state_;
+        while ( last_ != first_ ) {
+            *--last_ = rtype ( state >> ( STYPE_BITS - RTYPE_BITS ) );
+            state *= MCG_INVERSE;
+        }
+        state_ = state;
+    }
+
     bool operator== ( const mcg128 & rhs ) { return ( state_ == rhs.state_ ); }
 
     bool operator!= ( const mcg128 & rhs ) { return !operator== ( rhs ); }
@@ -350,6 +512,7 @@ template<typename rtype, typename stype>
 class mcg128_fast {
     stype state_;
     static constexpr uint64_t MCG_MULT = 0xda942042e4dd58b5ULL;
+    static constexpr stype MCG_INVERSE = mcg_inverse<stype> ( MCG_MULT );
 
     static constexpr unsigned int STYPE_BITS = 8 * sizeof ( stype );
     static constexpr unsigned int RTYPE_BITS = 8 * sizeof ( rtype );
@@ -366,12 +529,35 @@ class mcg128_fast {
     void seed ( const rtype s_ ) { state_ = stype{ s_ | 1 }; }
 
     void advance ( ) { state_ *= MCG_MULT; }
+    void retreat ( ) { state_ *= MCG_INVERSE; }
+
+    [[nodiscard]] stype state ( ) const noexcept { return state_; }
+    [[nodiscard]] static constexpr stype multiplier ( ) noexcept { return MCG_MULT; }
 
     result_type operator( ) ( ) {
         advance ( );
         return result_type ( state_ >> ( STYPE_BITS - RTYPE_BITS ) );
     }
 
+    void generate ( rtype * first_, rtype * const last_ ) {
+        stype state = state_;
+        for ( ; first_ != last_; ++first_ ) {
+            state *= MCG_MULT;
+            *first_ = rtype ( state >> ( STYPE_BITS - RTYPE_BITS ) );
+        }
+        state_ = state;
+    }
+
+    // Undoes generate ( first_, last_ ), see jsf.
+    void generate_backward ( rtype * const first_, rtype * last_ ) {
+        stype state = state_;
+        while ( last_ != first_ ) {
+            *--last_ = rtype ( state >> ( STYPE_BITS - RTYPE_BITS ) );
+            state *= MCG_INVERSE;
+        }
+        state_ = state;
+    }
+
     bool operator== ( const mcg128_fast & rhs ) { return ( state_ == rhs.state_ ); }
 
     bool operator!= ( const mcg128_fast & rhs ) { return !operator== ( rhs ); }
@@ -386,9 +572,11 @@ class mcg128_fast {
 using mcg128      = lehmer_detail::mcg128<uint64_t, __uint128_t>;
 using mcg128_fast = lehmer_detail::mcg128_fast<uint64_t, __uint128_t>;
 
-*/
 
-template<std::size_t S>
+// The windows of GMPRng's S-limb result that next and generate_integers return.
+enum class limb_window { all, low_half, high_half, middle_half };
+
+template<std::size_t S, typename Instrumentation = no_instrumentation>
 struct GMPRng {
 
     static_assert ( S % 2 == 0, "size has to be even" );
@@ -398,58 +586,259 @@ struct GMPRng {
     static_mpz_t _state;
     mp_limb_t * _destination;
 
-    GMPRng ( ) noexcept : _state ( _state_storage_0 ), _destination ( _state_storage_1.data ( ) ) {
+    explicit GMPRng ( const std::size_t multiplier_index_ = 0 ) noexcept :
+        _state ( _state_storage_0 ), _destination ( _state_storage_1.data ( ) ) {
         _state.randomize ( Rng::gen ( ), S );
         _state.make_odd ( );
-        static_mpz_t multiplier ( _multiplier_storage );
-        multiplier.randomize ( Rng::gen ( ) );
-        multiplier.make_odd ( );
+        vetted_multiplier<S> ( _multiplier_storage.data ( ), multiplier_index_ );
+    }
+
+    GMPRng ( const GMPRng & rhs_ ) noexcept { *this = rhs_; }
+
+    // The state and destination point into the own storage.
+    GMPRng & operator= ( const GMPRng & rhs_ ) noexcept {
+        _state_storage_0    = rhs_._state_storage_0;
+        _state_storage_1    = rhs_._state_storage_1;
+        _multiplier_storage = rhs_._multiplier_storage;
+        _state              = rhs_._state;
+        _state._mp_d        = rebase ( rhs_, rhs_._state._mp_d );
+        _destination        = rebase ( rhs_, rhs_._destination );
+        return *this;
+    }
+
+    [[nodiscard]] mp_limb_t * rebase ( const GMPRng & rhs_, const mp_limb_t * p_ ) noexcept {
+        const std::less<const mp_limb_t *> less;
+        if ( not less ( p_, rhs_._state_storage_0.data ( ) ) and less ( p_, rhs_._state_storage_0.data ( ) + 2 * S ) )
+            return _state_storage_0.data ( ) + ( p_ - rhs_._state_storage_0.data ( ) );
+        return _state_storage_1.data ( ) + ( p_ - rhs_._state_storage_1.data ( ) );
     }
 
     static_mpz_t & operator( ) ( ) noexcept {
-        mpn_mul_n ( _destination, _state._mp_d, _multiplier_storage.data ( ), S );
+        Instrumentation::on_block ( S * sizeof ( mp_limb_t ) );
+        big_mul_n ( _destination, _state._mp_d, _multiplier_storage.data ( ), S );
         std::swap ( _destination, _state._mp_d );
         std::copy_n ( _state._mp_d + ( S - 1 ), S, _state._mp_d );
         return _state;
     }
+
+    // Big-integer stream mode: each result is a random S-limb integer (the
+    // window of the product kept as the next state), or the low, high or
+    // middle half of its limbs.
+    [[nodiscard]] static constexpr std::size_t window_size ( const limb_window w_ ) noexcept {
+        return w_ == limb_window::all ? S : S / 2;
+    }
+    [[nodiscard]] static constexpr std::size_t window_offset ( const limb_window w_ ) noexcept {
+        return w_ == limb_window::high_half ? S / 2 : w_ == limb_window::middle_half ? S / 4 : 0;
+    }
+
+    // The next integer, valid until the next call.
+    template<limb_window Window = limb_window::all>
+    [[nodiscard]] std::span<const mp_limb_t, window_size ( Window )> next ( ) noexcept {
+        return std::span<const mp_limb_t, window_size ( Window )> ( operator( ) ( )._mp_d + window_offset ( Window ),
+                                                                      window_size ( Window ) );
+    }
+
+    // Writes the next n_ integers, window_size ( Window ) limbs each, to out_,
+    // one big_mul_n and one copy per integer. Each state is multiplied from
+    // where it lands: with all limbs, the integer written; with half of them,
+    // the product, the two buffers taking turns. It's moved into place once,
+    // at the end.
+    template<limb_window Window = limb_window::all>
+    void generate_integers ( mp_limb_t * out_, const std::size_t n_ ) noexcept {
+        constexpr std::size_t size = window_size ( Window ), offset = window_offset ( Window );
+        Instrumentation::on_block ( n_ * size * sizeof ( mp_limb_t ) );
+        const mp_limb_t * state = _state._mp_d;
+        for ( std::size_t i = 0; i < n_; ++i, out_ += size ) {
+            big_mul_n ( _destination, state, _multiplier_storage.data ( ), S );
+            if constexpr ( Window == limb_window::all ) {
+                std::copy_n ( _destination + ( S - 1 ), S, out_ );
+                state = out_;
+            }
+            else {
+                std::copy_n ( _destination + ( S - 1 ) + offset, size, out_ );
+                state = _destination + ( S - 1 );
+                std::swap ( _destination, _state._mp_d );
+            }
+        }
+        if ( n_ )
+            std::copy_n ( state, S, _state._mp_d );
+    }
 };
 
-template<std::size_t S>
+// GMPRng for huge S, tens of thousands of limbs and up, where mpn_mul_n is
+// FFT based and transforms the (constant) multiplier again on every step:
+// the product goes through an ntt_multiplier ( ntt.hpp ), which transformed
+// it once. The same results as GMPRng<S> with the same state and multiplier.
+// The storage is on the heap.
+template<std::size_t S, typename Instrumentation = no_instrumentation>
+struct GMPRngHuge {
+
+    static_assert ( S % 2 == 0, "size has to be even" );
+
+    std::vector<mp_limb_t> _state_storage, _product;
+    ntt_multiplier _multiplier;
+    static_mpz_t _state;
+
+    explicit GMPRngHuge ( const std::size_t multiplier_index_ = 0 ) : _state_storage ( S ), _product ( 2 * S ) {
+        _state = static_mpz_t ( S, 0, _state_storage.data ( ) );
+        _state.randomize ( Rng::gen ( ), S );
+        _state.make_odd ( );
+        std::vector<mp_limb_t> multiplier ( S );
+        vetted_multiplier<S> ( multiplier.data ( ), multiplier_index_ );
+        _multiplier = ntt_multiplier ( multiplier.data ( ), S, S );
+    }
+
+    // _state points into the own ( moved ) storage.
+    GMPRngHuge ( const GMPRngHuge & ) = delete;
+    GMPRngHuge ( GMPRngHuge && ) noexcept = default;
+
+    static_mpz_t & operator( ) ( ) {
+        Instrumentation::on_block ( S * sizeof ( mp_limb_t ) );
+        _multiplier.multiply ( _state._mp_d, _product.data ( ) );
+        std::copy_n ( _product.data ( ) + ( S - 1 ), S, _state._mp_d );
+        return _state;
+    }
+};
+
+// Output is raw_output or rxs_m_xs_output ( tempering.hpp ).
+template<std::size_t S, int Used = 2, typename Output = raw_output, typename Instrumentation = no_instrumentation>
 struct GMPRng2 {
 
     static_assert ( S % 2 == 0, "size has to be even" );
+    static_assert ( Used > 0 and Used <= int ( S ), "used has to be in [ 1, S ]" );
 
     using result_type = std::uint64_t;
     [[nodiscard]] static constexpr result_type min ( ) noexcept { return result_type ( 0 ); }
     [[nodiscard]] static constexpr result_type max ( ) noexcept { return ~result_type ( 0 ); }
 
+    // Number of multiplier limbs used by advance ( ).
+    static constexpr int used = Used;
+
     static_mpz_storage_t<2 * S> _state_storage_0, _state_storage_1;
-    static_mpz_storage_t<S> _multiplier_storage;
+    static_mpz_storage_t<Used> _multiplier_storage;
     static_mpz_t _state;
     mp_limb_t * _destination;
-    int _limb = 0;
+    int _limb                     = 0;
+    mp_limb_t _multiplier_inverse = 0; // Mod 2^64, at the first retreat ( ).
+
+    // A 128-bit seed from Rng.
+    GMPRng2 ( ) noexcept : GMPRng2 ( std::array<std::uint64_t, 2>{ Rng::gen ( ) ( ), Rng::gen ( ) ( ) } ) {}
+
+    // The state expanded from a 64-bit seed, the multiplier vetted multiplier
+    // multiplier_index_ ( multipliers.hpp ).
+    explicit GMPRng2 ( const std::uint64_t seed_, const std::size_t multiplier_index_ = 0 ) noexcept :
+        _state ( _state_storage_0 ), _destination ( _state_storage_1.data ( ) + ( S - 1 ) ) {
+        expand ( &seed_, 1 );
+        vetted_multiplier<used> ( _multiplier_storage.data ( ), multiplier_index_ );
+    }
 
-    GMPRng2 ( ) noexcept : _state ( _state_storage_0 ), _destination ( _state_storage_1.data ( ) + ( S - 1 ) ) {
-        _state._mp_d += ( S - 1 );
-        _state.randomize ( Rng::gen ( ), S );
+    // The same from a 128-bit seed.
+    explicit GMPRng2 ( const std::array<std::uint64_t, 2> & seed_, const std::size_t multiplier_index_ = 0 ) noexcept :
+        _state ( _state_storage_0 ), _destination ( _state_storage_1.data ( ) + ( S - 1 ) ) {
+        expand ( seed_.data ( ), 2 );
+        vetted_multiplier<used> ( _multiplier_storage.data ( ), multiplier_index_ );
+    }
+
+    // Limb i of the state is substream i / words_ of seed word i % words_
+    // (splitmix64, parallel_generate.hpp), so distinct seeds give distinct
+    // states, at a few cycles per limb.
+    void expand ( const std::uint64_t * seed_, const std::size_t words_ ) noexcept {
+        _state._mp_d = _state_storage_0.data ( ) + ( S - 1 );
+        _state.resize ( S );
+        for ( std::size_t i = 0; i < S; ++i )
+            _state._mp_d[ i ] = rng::substream_seed ( seed_[ i % words_ ], i / words_ );
         _state.make_odd ( );
-        static_mpz_t multiplier ( _multiplier_storage );
-        multiplier.randomize ( Rng::gen ( ) );
-        multiplier.make_odd ( );
+        _limb = 0;
+    }
+
+    GMPRng2 ( const GMPRng2 & rhs_ ) noexcept { *this = rhs_; }
+
+    // The state and destination point into the own storage.
+    GMPRng2 & operator= ( const GMPRng2 & rhs_ ) noexcept {
+        _state_storage_0    = rhs_._state_storage_0;
+        _state_storage_1    = rhs_._state_storage_1;
+        _multiplier_storage = rhs_._multiplier_storage;
+        _state              = rhs_._state;
+        _state._mp_d        = rebase ( rhs_, rhs_._state._mp_d );
+        _destination        = rebase ( rhs_, rhs_._destination );
+        _limb               = rhs_._limb;
+        _multiplier_inverse = rhs_._multiplier_inverse;
+        return *this;
+    }
+
+    [[nodiscard]] mp_limb_t * rebase ( const GMPRng2 & rhs_, const mp_limb_t * p_ ) noexcept {
+        const std::less<const mp_limb_t *> less;
+        if ( not less ( p_, rhs_._state_storage_0.data ( ) ) and less ( p_, rhs_._state_storage_0.data ( ) + 2 * S ) )
+            return _state_storage_0.data ( ) + ( p_ - rhs_._state_storage_0.data ( ) );
+        return _state_storage_1.data ( ) + ( p_ - rhs_._state_storage_1.data ( ) );
     }
 
     inline void advance ( ) noexcept {
-        constexpr int used = 2;
+        Instrumentation::on_refill ( );
         mpn_mul ( _destination - ( S - 1 ) + ( S - used ), _state._mp_d, S, _multiplier_storage.data ( ), used );
         std::swap ( _destination, _state._mp_d );
         _limb = 1;
     }
 
+    // The inverse of advance ( ), with Used == 1 only: the step is then x m mod
+    // 2^64S, undone by the 2-adic division by m, limb by limb ( mpn_bdiv_q_1's
+    // loop ), at the cost of the step. With more multiplier limbs the step
+    // drops the low Used - 1 limbs of the product, and is not a bijection.
+    void retreat ( ) noexcept {
+        static_assert ( Used == 1, "retreat needs a single limb multiplier" );
+        Instrumentation::on_refill ( );
+        const mp_limb_t m = _multiplier_storage[ 0 ];
+        if ( not _multiplier_inverse )
+            _multiplier_inverse = limb_inverse ( m );
+        const mp_limb_t * y = _state._mp_d;
+        mp_limb_t c         = 0;
+        for ( std::size_t i = 0; i < S; ++i ) {
+            const mp_limb_t q = ( y[ i ] - c ) * _multiplier_inverse;
+            c                 = mp_limb_t ( ( __uint128_t{ q } * m ) >> 64 ) + ( y[ i ] < c );
+            _destination[ i ] = q;
+        }
+        std::swap ( _destination, _state._mp_d );
+    }
+
     [[nodiscard]] result_type operator( ) ( ) noexcept {
+        Instrumentation::on_value ( sizeof ( result_type ) );
         if ( _limb != S )
-            return _state._mp_d[ _limb++ ];
+            return Output::apply ( _state._mp_d[ _limb++ ] );
         advance ( );
-        return _state._mp_d[ 0 ];
+        return Output::apply ( _state._mp_d[ 0 ] );
+    }
+
+    // Fills [ first_, last_ ) with the next values, copying whole limb runs out
+    // of the state through Output, the bulk path.
+    void generate ( result_type * first_, result_type * const last_ ) noexcept {
+        Instrumentation::on_block ( ( last_ - first_ ) * sizeof ( result_type ) );
+        while ( first_ != last_ ) {
+            if ( _limb == S ) {
+                advance ( );
+                _limb = 0;
+            }
+            const int n = int ( std::min<std::ptrdiff_t> ( S - _limb, last_ - first_ ) );
+            Output::apply ( _state._mp_d + _limb, first_, n );
+            first_ += n;
+            _limb += n;
+        }
+    }
+
+    // Undoes generate ( first_, last_ ): writes the last_ - first_ values up to
+    // the current position, in their ( forward ) order, and moves back over
+    // them, retreating the state ( Used == 1 ) at the start of each.
+    void generate_backward ( result_type * const first_, result_type * last_ ) noexcept {
+        Instrumentation::on_block ( ( last_ - first_ ) * sizeof ( result_type ) );
+        while ( last_ != first_ ) {
+            if ( not _limb ) {
+                retreat ( );
+                _limb = S;
+            }
+            const int n = int ( std::min<std::ptrdiff_t> ( _limb, last_ - first_ ) );
+            last_ -= n;
+            _limb -= n;
+            Output::apply ( _state._mp_d + _limb, last_, n );
+        }
     }
 
     [[nodiscard]] bool operator== ( const GMPRng2 & rhs_ ) noexcept { return ( _state == rhs_._state ); }
@@ -457,14 +846,893 @@ struct GMPRng2 {
 };
 
 
+// Stream distances ( stream_distance.hpp ).
+
+namespace lehmer_detail {
 
+template<typename Mcg>
+[[nodiscard]] std::optional<__uint128_t> mcg_distance ( const Mcg & a_, const Mcg & b_ ) {
+    const auto limbs = [] ( const __uint128_t x_ ) { return std::array<mp_limb_t, 2>{ mp_limb_t ( x_ ), mp_limb_t ( x_ >> 64 ) }; };
+    static const lehmer_cycles<2> cycles ( limbs ( Mcg::multiplier ( ) ).data ( ), 2 );
+    const auto d = cycles.distance ( limbs ( a_.state ( ) ).data ( ), limbs ( b_.state ( ) ).data ( ) );
+    if ( not d )
+        return std::nullopt;
+    return ( __uint128_t{ ( *d )[ 1 ] } << 64 ) | ( *d )[ 0 ];
+}
+
+} // namespace lehmer_detail
 
-using Generator = jsf64;
+// The number of draws that take a_ to b_ ( mod the period, 2^126 ), or nothing
+// if b_ is not on a_'s cycle.
+template<typename rtype, typename stype>
+[[nodiscard]] std::optional<__uint128_t> distance ( const lehmer_detail::mcg128<rtype, stype> & a_,
+                                                    const lehmer_detail::mcg128<rtype, stype> & b_ ) {
+    return lehmer_detail::mcg_distance ( a_, b_ );
+}
+template<typename rtype, typename stype>
+[[nodiscard]] std::optional<__uint128_t> distance ( const lehmer_detail::mcg128_fast<rtype, stype> & a_,
+                                                    const lehmer_detail::mcg128_fast<rtype, stype> & b_ ) {
+    return lehmer_detail::mcg_distance ( a_, b_ );
+}
+
+// The cycles of the step of GMPRng2<S, 1> with rng_'s multiplier, x -> x m mod
+// 2^64S, 64 S products of S limbs to set up.
+template<std::size_t S, typename Output, typename Instrumentation>
+[[nodiscard]] lehmer_cycles<S> stream_cycles ( const GMPRng2<S, 1, Output, Instrumentation> & rng_ ) {
+    return lehmer_cycles<S> ( rng_._multiplier_storage.data ( ), 1 );
+}
+
+// The number of values ( draws ) that take a_ to b_, mod the period, or nothing
+// if b_ is not on a_'s cycle or has another multiplier.
+template<std::size_t S, typename Output, typename Instrumentation>
+[[nodiscard]] std::optional<mpz_class> distance ( const lehmer_cycles<S> & cycles_, const GMPRng2<S, 1, Output, Instrumentation> & a_,
+                                                  const GMPRng2<S, 1, Output, Instrumentation> & b_ ) {
+    if ( a_._multiplier_storage != b_._multiplier_storage )
+        return std::nullopt;
+    const auto steps = cycles_.distance ( a_._state._mp_d, b_._state._mp_d );
+    if ( not steps )
+        return std::nullopt;
+    mpz_class d, period;
+    mpz_import ( d.get_mpz_t ( ), S, -1, sizeof ( mp_limb_t ), 0, 0, steps->data ( ) );
+    mpz_setbit ( period.get_mpz_t ( ), cycles_.log2_period ( ) );
+    d = d * S + b_._limb - a_._limb;
+    period *= S;
+    mpz_mod ( d.get_mpz_t ( ), d.get_mpz_t ( ), period.get_mpz_t ( ) );
+    return d;
+}
+template<std::size_t S, typename Output, typename Instrumentation>
+[[nodiscard]] std::optional<mpz_class> distance ( const GMPRng2<S, 1, Output, Instrumentation> & a_,
+                                                  const GMPRng2<S, 1, Output, Instrumentation> & b_ ) {
+    return distance ( stream_cycles ( a_ ), a_, b_ );
+}
+
+
+
+#include "async_blocks.hpp"
+#include "bernoulli_bits.hpp"
+#include "autotune.hpp"
+#include "block_pool.hpp"
+#include "block_service.hpp"
+#include "geometric_skip.hpp"
+#include "gf2_lehmer.hpp"
+#include "lehmer_lanes.hpp"
+#include "random_view.hpp"
+#include "sobol.hpp"
+#include "tuned_generator.hpp"
+#include "variance_reduction.hpp"
+#include "weighted_reservoir.hpp"
+#include "zipf.hpp"
+
+using Generator = tuned_generator;
  // GMPRng2<64>;
 
+// gmp_random search-multipliers <candidates> <keep> <limbs>[:<candidates>]...
+//
+// Writes multipliers.hpp to stdout, with a table of the keep best of candidates
+// random multipliers for each of the given limb counts.
+int search_multipliers_main ( int argc, char ** argv ) {
+    if ( argc < 5 ) {
+        std::cerr << "usage: gmp_random search-multipliers <candidates> <keep> <limbs>[:<candidates>]..." << nl;
+        return EXIT_FAILURE;
+    }
+    const std::size_t candidates = std::strtoull ( argv[ 2 ], nullptr, 10 ), keep = std::strtoull ( argv[ 3 ], nullptr, 10 );
+    std::vector<std::vector<vetted_multiplier_t>> tables;
+    std::string command = "gmp_random search-multipliers";
+    for ( int i = 2; i < argc; ++i )
+        command += std::string ( " " ) + argv[ i ];
+    for ( int i = 4; i < argc; ++i ) {
+        char * end;
+        const std::size_t limbs = std::strtoull ( argv[ i ], &end, 10 );
+        tables.push_back ( search_multipliers<jsf64> ( limbs, *end == ':' ? std::strtoull ( end + 1, nullptr, 10 ) : candidates, keep ) );
+    }
+    std::cout.precision ( 6 );
+    emit_multiplier_header ( std::cout, command, tables );
+    return EXIT_SUCCESS;
+}
+
+// gmp_random autotune [<max_log2> [<header>]]
+//
+// Measures throughput and the first failing size of the embedded battery (up to
+// 2^max_log2 bytes) of each configuration, prints the Pareto frontier (marked *)
+// and writes the recommended default to header (tuned_generator.hpp).
+int autotune_main ( int argc, char ** argv ) {
+    const int max_log2 = argc > 2 ? std::atoi ( argv[ 2 ] ) : 28;
+    std::vector<tune_result_t> results;
+    auto add = [ & ]( auto t, const char * name ) {
+        results.push_back ( tune<typename decltype ( t )::type> ( name, max_log2 ) );
+        std::cerr << '.';
+    };
+#define GMP_RANDOM_TUNE( ... ) add ( std::common_type<__VA_ARGS__> ( ), #__VA_ARGS__ )
+    GMP_RANDOM_TUNE ( jsf32na );
+    GMP_RANDOM_TUNE ( jsf32ra );
+    GMP_RANDOM_TUNE ( jsf32rb );
+    GMP_RANDOM_TUNE ( jsf32rc );
+    GMP_RANDOM_TUNE ( jsf32rd );
+    GMP_RANDOM_TUNE ( jsf32re );
+    GMP_RANDOM_TUNE ( jsf32rf );
+    GMP_RANDOM_TUNE ( jsf32rg );
+    GMP_RANDOM_TUNE ( jsf32rh );
+    GMP_RANDOM_TUNE ( jsf32ri );
+    GMP_RANDOM_TUNE ( jsf32rj );
+    GMP_RANDOM_TUNE ( jsf32rk );
+    GMP_RANDOM_TUNE ( jsf32rl );
+    GMP_RANDOM_TUNE ( jsf32rm );
+    GMP_RANDOM_TUNE ( jsf32rn );
+    GMP_RANDOM_TUNE ( jsf32ro );
+    GMP_RANDOM_TUNE ( jsf32rp );
+    GMP_RANDOM_TUNE ( jsf32rq );
+    GMP_RANDOM_TUNE ( jsf32rr );
+    GMP_RANDOM_TUNE ( jsf32rs );
+    GMP_RANDOM_TUNE ( jsf32rt );
+    GMP_RANDOM_TUNE ( jsf32ru );
+    GMP_RANDOM_TUNE ( jsf32rv );
+    GMP_RANDOM_TUNE ( jsf32rw );
+    GMP_RANDOM_TUNE ( jsf64na );
+    GMP_RANDOM_TUNE ( jsf64ra );
+    GMP_RANDOM_TUNE ( GMPRng2<4, 2> );
+    GMP_RANDOM_TUNE ( GMPRng2<8, 2> );
+    GMP_RANDOM_TUNE ( GMPRng2<16, 2> );
+    GMP_RANDOM_TUNE ( GMPRng2<32, 2> );
+    GMP_RANDOM_TUNE ( GMPRng2<64, 2> );
+    GMP_RANDOM_TUNE ( GMPRng2<128, 2> );
+    GMP_RANDOM_TUNE ( GMPRng2<16, 4> );
+    GMP_RANDOM_TUNE ( GMPRng2<32, 4> );
+    GMP_RANDOM_TUNE ( GMPRng2<64, 4> );
+    GMP_RANDOM_TUNE ( GMPRng2<128, 4> );
+    GMP_RANDOM_TUNE ( GMPRng2<16, 2, rxs_m_xs_output> );
+    GMP_RANDOM_TUNE ( GMPRng2<64, 2, rxs_m_xs_output> );
+#undef GMP_RANDOM_TUNE
+    std::cerr << nl;
+    const std::size_t best = pareto_frontier ( results );
+    print_tune_results ( std::cout, results, max_log2 );
+    std::cout << "recommended: " << results[ best ].name << nl;
+    std::ofstream header ( argc > 3 ? argv[ 3 ] : "tuned_generator.hpp" );
+    emit_tuned_generator ( header, results[ best ], max_log2 );
+    return EXIT_SUCCESS;
+}
+
+// gmp_random stats <name>
+//
+// Prints the counters last published to the stats page name.
+int stats_main ( int argc, char ** argv ) {
+    if ( argc < 3 ) {
+        std::cerr << "usage: gmp_random stats <name>" << nl;
+        return EXIT_FAILURE;
+    }
+    const stats_page_t page ( argv[ 2 ], false );
+    engine_counters_t c;
+    if ( not page or not page.read ( c ) ) {
+        std::cerr << "no stats page: " << argv[ 2 ] << nl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "values " << c.values << nl << "bytes " << c.bytes << nl << "blocks " << c.blocks << nl << "reseeds "
+              << c.reseeds << nl << "refills " << c.refills << nl;
+    return EXIT_SUCCESS;
+}
+
+struct serve_tag {};
+using serve_engine = GMPRng2<64, 2, raw_output, counting_instrumentation<serve_tag>>;
+
+// gmp_random serve <name> [<threads> [<slots>]]
+//
+// Runs a block service of GMPRng2<64> engines, one producer thread each, until
+// stdin is closed. The engines are instrumented, their counters are published
+// to the stats page <name>-stats ( see gmp_random stats ) every 100 ms.
+int serve_main ( int argc, char ** argv ) {
+    if ( argc < 3 ) {
+        std::cerr << "usage: gmp_random serve <name> [<threads> [<slots>]]" << nl;
+        return EXIT_FAILURE;
+    }
+    const std::string stats_name = std::string ( argv[ 2 ] ) + "-stats";
+    const stats_publisher<counting_instrumentation<serve_tag>> stats ( stats_name.c_str ( ) );
+    if ( not stats ) {
+        std::cerr << "cannot create: " << stats_name << " ( in use? )" << nl;
+        return EXIT_FAILURE;
+    }
+    const std::vector<serve_engine> engines ( argc > 3 ? std::atoi ( argv[ 3 ] ) : 2 );
+    const block_service<serve_engine> service ( argv[ 2 ], engines, argc > 4 ? std::strtoull ( argv[ 4 ], nullptr, 10 ) : 1'024 );
+    if ( not service ) {
+        std::cerr << "cannot create: " << argv[ 2 ] << " ( in use? )" << nl;
+        return EXIT_FAILURE;
+    }
+    while ( std::cin.get ( ) != EOF )
+        ;
+    return EXIT_SUCCESS;
+}
+
+// gmp_random client <name>
+//
+// Writes the blocks of the block service name to stdout, for RNG_test.
+int client_main ( int argc, char ** argv ) {
+    if ( argc < 3 ) {
+        std::cerr << "usage: gmp_random client <name>" << nl;
+        return EXIT_FAILURE;
+    }
+    block_client client ( argv[ 2 ] );
+    if ( not client ) {
+        std::cerr << "no block service: " << argv[ 2 ] << nl;
+        return EXIT_FAILURE;
+    }
+#ifdef _WIN32
+    _setmode ( _fileno ( stdout ), _O_BINARY );
+#endif
+    std::vector<std::uint64_t> block ( client.block_words ( ) );
+    while ( std::cout ) {
+        client.read ( block.data ( ) );
+        std::cout.write ( reinterpret_cast<char *> ( block.data ( ) ), block.size ( ) * sizeof ( std::uint64_t ) );
+    }
+    return EXIT_SUCCESS;
+}
+
+// Reads `<seed> <values>` lines from in_, the substreams of GMPRng2<S, 1> (
+// seed, multiplier_index_ ), and prints the pairs of lines ( from 0 ) whose
+// streams overlap.
+template<std::size_t S>
+int check_streams ( std::istream & in_, const std::size_t multiplier_index_ ) {
+    const lehmer_cycles<S> cycles = stream_cycles ( GMPRng2<S, 1> ( std::uint64_t{ 0 }, multiplier_index_ ) );
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> table;
+    std::uint64_t seed, values;
+    while ( in_ >> seed >> values )
+        table.emplace_back ( seed, values );
+    std::vector<stream_t<S>> streams ( table.size ( ) );
+    std::transform ( std::execution::par, table.begin ( ), table.end ( ), streams.begin ( ), [ & ]( const auto & t_ ) {
+        const GMPRng2<S, 1> rng ( t_.first, multiplier_index_ );
+        return stream_t<S>{ cycles.locate ( rng._state._mp_d ), t_.second / S + ( t_.second % S != 0 ) };
+    } );
+    const auto pairs = overlapping_streams ( cycles, streams );
+    for ( const auto & [ i, j ] : pairs )
+        std::cout << i << ' ' << j << nl;
+    std::cerr << streams.size ( ) << " streams, " << pairs.size ( ) << " overlapping pairs" << nl;
+    return pairs.empty ( ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// gmp_random streams <limbs> [<multiplier_index>]
+//
+// Checks an allocation of GMPRng2<limbs, 1> substreams, limbs 4, 16 or 64, read
+// from stdin, for overlaps, see check_streams. Fails if there are any.
+int streams_main ( int argc, char ** argv ) {
+    const std::size_t limbs = argc > 2 ? std::strtoull ( argv[ 2 ], nullptr, 10 ) : 0,
+                      index = argc > 3 ? std::strtoull ( argv[ 3 ], nullptr, 10 ) : 0;
+    if ( limbs == 4 )
+        return check_streams<4> ( std::cin, index );
+    if ( limbs == 16 )
+        return check_streams<16> ( std::cin, index );
+    if ( limbs == 64 )
+        return check_streams<64> ( std::cin, index );
+    std::cerr << "usage: gmp_random streams 4|16|64 [<multiplier_index>] < <seed> <values>..." << nl;
+    return EXIT_FAILURE;
+}
+
+// Nanoseconds per block of S limbs of GMPRng2<S, 2, Output>, through generate.
+template<std::size_t S, typename Output>
+[[nodiscard]] double ns_per_block ( const std::size_t blocks_ = std::size_t{ 1 } << 16 ) {
+    GMPRng2<S, 2, Output> rng;
+    std::vector<std::uint64_t> block ( S );
+    std::uint64_t x = 0;
+    plf::nanotimer timer;
+    timer.start ( );
+    for ( std::size_t i = 0; i < blocks_; ++i ) {
+        rng.generate ( block.data ( ), block.data ( ) + S );
+        x += block[ i % S ];
+    }
+    const double t = timer.get_elapsed_ns ( );
+    volatile std::uint64_t sink = x;
+    ( void ) sink;
+    return t / blocks_;
+}
+
+template<std::size_t S>
+void bench_tempering ( ) {
+    const double raw = ns_per_block<S, raw_output> ( ), tempered = ns_per_block<S, rxs_m_xs_output> ( );
+    std::cout << "GMPRng2<" << S << ">" << std::string ( S < 10 ? 3 : S < 100 ? 2 : 1, ' ' ) << raw << " ns raw  " << tempered
+              << " ns tempered  " << 100.0 * ( tempered - raw ) / raw << "%" << nl;
+}
+
+// Nanoseconds per value of Engine, drawn in blocks of Block values.
+template<typename Engine, std::size_t Block>
+[[nodiscard]] double ns_per_value ( Engine & rng_, const std::size_t values_ = std::size_t{ 1 } << 24 ) {
+    std::vector<std::uint64_t> block ( Block );
+    std::uint64_t x = 0;
+    plf::nanotimer timer;
+    timer.start ( );
+    for ( std::size_t i = 0; i < values_; i += Block ) {
+        rng_.generate ( block.data ( ), block.data ( ) + Block );
+        x += block[ i % Block ];
+    }
+    const double t = timer.get_elapsed_ns ( );
+    volatile std::uint64_t sink = x;
+    ( void ) sink;
+    return t / values_;
+}
+
+// Lanes scalar GMPRng2<S> (mpn_mul) against one lehmer_lanes<S, Lanes>, the
+// same amount of output, in the same interleaved blocks.
+template<std::size_t S, std::size_t Lanes = 8>
+void bench_lanes ( ) {
+    struct scalar_lanes {
+        std::array<GMPRng2<S>, Lanes> lanes;
+        void generate ( std::uint64_t * first_, std::uint64_t * const ) noexcept {
+            for ( auto & l : lanes )
+                l.generate ( first_, first_ + S ), first_ += S;
+        }
+    } scalar;
+    lehmer_lanes<S, Lanes> simd;
+    const double a = ns_per_value<scalar_lanes, S * Lanes> ( scalar ), b = ns_per_value<lehmer_lanes<S, Lanes>, S * Lanes> ( simd );
+    std::cout << "S = " << S << std::string ( S < 10 ? 3 : 2, ' ' ) << a << " ns scalar  " << b << " ns lanes  " << a / b << "x" << nl;
+}
+
+// gf2_lehmer<Words> against GMPRng2<Words>, the same state size.
+template<std::size_t Words>
+void bench_gf2 ( ) {
+    gf2_lehmer<Words> gf2;
+    GMPRng2<Words> integer;
+    const double a = ns_per_value<GMPRng2<Words>, 512> ( integer ), b = ns_per_value<gf2_lehmer<Words>, 512> ( gf2 );
+    std::cout << "k = " << 64 * Words << std::string ( Words < 2 ? 4 : Words < 16 ? 3 : 2, ' ' ) << a << " ns integer  " << b
+              << " ns gf2" << nl;
+}
+
+// Sums n_ blocks of source_, co_awaiting each.
+template<typename Source>
+async_task<std::uint64_t> sum_blocks ( Source & source_, std::size_t n_ ) {
+    std::uint64_t sum = 0;
+    while ( n_-- ) {
+        const auto block = co_await source_.next_block ( );
+        for ( const auto v : block )
+            sum += v;
+    }
+    co_return sum;
+}
+
+// Nanoseconds per value of a coroutine summing the blocks of an
+// async_block_source, against fill_block and the sum on one thread.
+template<typename Engine>
+void bench_async ( const char * name_ ) {
+    constexpr std::size_t blocks = std::size_t{ 1 } << 14;
+    Engine rng ( std::uint64_t{ 1 } );
+    std::array<typename Engine::result_type, 512> block;
+    plf::nanotimer timer;
+    timer.start ( );
+    std::uint64_t direct = 0;
+    for ( std::size_t i = 0; i < blocks; ++i ) {
+        fill_block ( rng, block.data ( ), block.data ( ) + block.size ( ) );
+        for ( const auto v : block )
+            direct += v;
+    }
+    const double synchronous = timer.get_elapsed_ns ( ) / ( blocks * block.size ( ) );
+    thread_executor producer;
+    async_block_source<Engine> source ( Engine ( std::uint64_t{ 1 } ), producer );
+    timer.start ( );
+    const std::uint64_t awaited = sync_wait ( sum_blocks ( source, blocks ) );
+    const double coroutine      = timer.get_elapsed_ns ( ) / ( blocks * block.size ( ) );
+    std::cout << name_ << "  " << synchronous << " ns fill_block  " << coroutine << " ns co_await ( "
+              << ( awaited == direct ? "same" : "differs" ) << " )" << nl;
+}
+
+// Fill bandwidth of a buffer of mib_ MiB with Engine's output, with and
+// without the nontemporal hint, and the time to re-read a 1 MiB working set,
+// cached before the fill, after it (the cost of the cache pollution).
+template<typename Engine>
+void bench_stream ( const std::size_t mib_ ) {
+    using result_type = typename Engine::result_type;
+    std::vector<result_type> buffer ( ( mib_ << 20 ) / sizeof ( result_type ) );
+    std::vector<std::uint64_t> working ( ( std::size_t{ 1 } << 20 ) / sizeof ( std::uint64_t ), 1 );
+    Engine rng;
+    const auto run = [ & ]( const char * name_, auto fill_ ) {
+        double fill = 1e300, reread = 1e300;
+        for ( int i = 0; i < 3; ++i ) {
+            std::uint64_t x = std::accumulate ( working.begin ( ), working.end ( ), std::uint64_t{ 0 } );
+            plf::nanotimer timer;
+            timer.start ( );
+            fill_ ( );
+            fill = std::min ( fill, timer.get_elapsed_ns ( ) );
+            timer.start ( );
+            x += std::accumulate ( working.begin ( ), working.end ( ), std::uint64_t{ 0 } );
+            reread                      = std::min ( reread, timer.get_elapsed_ns ( ) );
+            volatile std::uint64_t sink = x + buffer[ i ];
+            ( void ) sink;
+        }
+        std::cout << name_ << ( mib_ << 20 ) / fill << " GB/s fill  " << reread / 1'000.0 << " us re-read" << nl;
+    };
+    run ( "temporal     ", [ & ] { fill_block ( rng, buffer.data ( ), buffer.data ( ) + buffer.size ( ) ); } );
+    run ( "non-temporal ", [ & ] { fill_block ( rng, buffer.data ( ), buffer.data ( ) + buffer.size ( ), nontemporal ); } );
+}
+
+// Nanoseconds per GMPRng2<S> construction, from Rng and from a 64-bit seed.
+template<std::size_t S>
+void bench_construct ( const std::size_t n_ = std::size_t{ 1 } << 14 ) {
+    std::uint64_t x = 0;
+    plf::nanotimer timer;
+    timer.start ( );
+    for ( std::size_t i = 0; i < n_; ++i )
+        x += GMPRng2<S> ( ) ( );
+    const double from_rng = timer.get_elapsed_ns ( ) / n_;
+    timer.start ( );
+    for ( std::size_t i = 0; i < n_; ++i )
+        x += GMPRng2<S> ( i ) ( );
+    const double from_seed      = timer.get_elapsed_ns ( ) / n_;
+    volatile std::uint64_t sink = x;
+    ( void ) sink;
+    std::cout << "GMPRng2<" << S << ">" << std::string ( S < 10 ? 3 : S < 100 ? 2 : 1, ' ' ) << from_rng << " ns from Rng  "
+              << from_seed << " ns from a seed" << nl;
+}
+
+// Microseconds per product of S limbs by mpn_mul_n ( a GMPRng<S> step by
+// default ) and by ntt_mul ( big_mul_n's opt-in path ), and per step of
+// GMPRngHuge<S>, best of the runs in about a second each.
+template<std::size_t S>
+void bench_huge ( ) {
+    const auto time = [] ( auto && step_ ) {
+        double best = 1e300, total = 0.0;
+        for ( int i = 0; i < 3 or ( i < 1'000 and total < 1e9 ); ++i ) {
+            plf::nanotimer timer;
+            timer.start ( );
+            step_ ( );
+            const double t = timer.get_elapsed_ns ( );
+            best           = std::min ( best, t );
+            total += t;
+        }
+        return best / 1'000.0;
+    };
+    std::vector<mp_limb_t> a ( S ), b ( S ), product ( 2 * S );
+    rng::generate ( a.begin ( ), a.end ( ), Rng::gen ( ), sax::uniform_int_distribution<mp_limb_t> ( ) );
+    rng::generate ( b.begin ( ), b.end ( ), Rng::gen ( ), sax::uniform_int_distribution<mp_limb_t> ( ) );
+    GMPRngHuge<S> huge;
+    std::uint64_t x = 0;
+    const double gmp = time ( [ & ] { mpn_mul_n ( product.data ( ), a.data ( ), b.data ( ), S ); } ),
+                 ntt = time ( [ & ] { ntt_mul ( product.data ( ), a.data ( ), S, b.data ( ), S ); } ),
+                 h   = time ( [ & ] { x += huge ( )._mp_d[ 0 ]; } );
+    volatile std::uint64_t sink = x + product[ 0 ];
+    ( void ) sink;
+    std::cout << "S = 2^" << std::countr_zero ( S ) << std::string ( S < ( 1 << 10 ) ? 2 : 1, ' ' ) << gmp << " us mpn_mul_n  " << ntt
+              << " us ntt_mul  " << gmp / ntt << "x  " << h << " us GMPRngHuge  " << gmp / h << "x" << nl;
+}
+
+// Nanoseconds per value of Engine's generate and generate_backward, over the
+// same blocks of Block values, back and forth.
+template<typename Engine, std::size_t Block = 4'096>
+void bench_retreat ( const char * name_, const std::size_t values_ = std::size_t{ 1 } << 24 ) {
+    Engine rng;
+    std::vector<typename Engine::result_type> block ( Block );
+    std::uint64_t x = 0;
+    double forward = 0.0, backward = 0.0;
+    plf::nanotimer timer;
+    for ( std::size_t i = 0; i < values_; i += Block ) {
+        timer.start ( );
+        rng.generate ( block.data ( ), block.data ( ) + Block );
+        forward += timer.get_elapsed_ns ( );
+        x += block[ i % Block ];
+        timer.start ( );
+        rng.generate_backward ( block.data ( ), block.data ( ) + Block );
+        backward += timer.get_elapsed_ns ( );
+        x += block[ i % Block ];
+    }
+    volatile std::uint64_t sink = x;
+    ( void ) sink;
+    std::cout << name_ << std::string ( 16 - std::strlen ( name_ ), ' ' ) << forward / values_ << " ns forward  " << backward / values_
+              << " ns backward" << nl;
+}
+
+// The successes among 2^28 trials of probability p_, a jsf64 draw per trial
+// against geometric_skip, and rng::gnp_edges, milliseconds.
+void bench_sparse ( const double p_ ) {
+    constexpr std::uint64_t trials = std::uint64_t{ 1 } << 28;
+    const std::uint64_t threshold  = std::uint64_t ( p_ * 0x1p64 );
+    std::vector<std::uint64_t> indices, block ( 4'096 );
+    jsf64 rng;
+    plf::nanotimer timer;
+    timer.start ( );
+    for ( std::uint64_t i = 0; i < trials; i += block.size ( ) ) {
+        rng.generate ( block.data ( ), block.data ( ) + block.size ( ) );
+        for ( std::size_t j = 0; j < block.size ( ); ++j )
+            if ( block[ j ] < threshold )
+                indices.push_back ( i + j );
+    }
+    const double per_trial = timer.get_elapsed_ms ( ), n = double ( indices.size ( ) );
+    indices.clear ( );
+    timer.start ( );
+    geometric_skip<jsf64> skips ( rng, p_ );
+    skips.successes ( 0, trials, std::back_inserter ( indices ) );
+    const double skipped = timer.get_elapsed_ms ( );
+    timer.start ( );
+    const auto edges  = rng::gnp_edges ( std::execution::par, std::uint64_t{ 1 } << 15, p_, rng );
+    const double gnp  = timer.get_elapsed_ms ( );
+    std::cout << "p = " << p_ << "  " << n << " / " << indices.size ( ) << " successes  " << per_trial << " ms per trial  " << skipped
+              << " ms skipping  " << per_trial / skipped << "x  G(2^15, p) " << edges.size ( ) << " edges " << gnp << " ms" << nl;
+}
+
+// Nanoseconds per word of Bernoulli ( p_ ) bits, a jsf64 draw per bit against
+// bernoulli_bits, and the engine words the latter takes per word.
+void bench_bernoulli ( const double p_ ) {
+    struct counted_jsf64 : jsf64 {
+        std::uint64_t words = 0;
+        void generate ( std::uint64_t * first_, std::uint64_t * const last_ ) {
+            words += last_ - first_;
+            jsf64::generate ( first_, last_ );
+        }
+    } rng;
+    const std::uint64_t threshold = std::uint64_t ( p_ * 0x1p64 );
+    std::vector<std::uint64_t> bits ( std::size_t{ 1 } << 18 );
+    plf::nanotimer timer;
+    timer.start ( );
+    for ( auto & w : bits ) {
+        w = 0;
+        for ( int i = 0; i < 64; ++i )
+            w |= std::uint64_t ( rng ( ) < threshold ) << i;
+    }
+    const double per_bit = timer.get_elapsed_ns ( ) / bits.size ( );
+    timer.start ( );
+    bernoulli_bits ( rng, p_, bits );
+    const double cascade = timer.get_elapsed_ns ( ) / bits.size ( );
+    std::uint64_t ones   = 0;
+    for ( const std::uint64_t w : bits )
+        ones += std::popcount ( w );
+    std::cout << "p = " << p_ << std::string ( p_ < 1e-3 ? 2 : 4, ' ' ) << per_bit << " ns per bit  " << cascade << " ns cascade  "
+              << double ( rng.words ) / bits.size ( ) << " words per word  frequency " << double ( ones ) / ( 64.0 * bits.size ( ) ) << nl;
+}
+
+// Nanoseconds per Zipf ( n, s_ ) key, jsf64, rejection-inversion at n = 10^9
+// and the alias table at n = 2^20 ( and its set-up, ms ).
+void bench_zipf ( const double s_ ) {
+    std::vector<std::uint64_t> keys ( std::size_t{ 1 } << 22 );
+    jsf64 rng;
+    plf::nanotimer timer;
+    timer.start ( );
+    zipf_distribution ( 1'000'000'000, s_ ).fill ( rng, keys );
+    const double rejection = timer.get_elapsed_ns ( ) / keys.size ( );
+    timer.start ( );
+    const zipf_table_distribution table ( 1u << 20, s_ );
+    const double setup = timer.get_elapsed_ms ( );
+    timer.start ( );
+    table.fill ( rng, keys );
+    const double alias = timer.get_elapsed_ns ( ) / keys.size ( );
+    std::cout << "s = " << s_ << std::string ( s_ == double ( int ( s_ ) ) ? 5 : 3, ' ' ) << rejection << " ns rejection-inversion  "
+              << alias << " ns alias table ( " << setup << " ms set-up )" << nl;
+}
+
+// Nanoseconds per item of a weighted sample of k_ of 2^26 items, a key per
+// item ( A-Res ) against weighted_reservoir ( A-ExpJ ), and rng::weighted_sample.
+void bench_reservoir ( const std::size_t k_ ) {
+    constexpr std::uint64_t n = std::uint64_t{ 1 } << 26;
+    const auto weight         = [] ( const std::uint64_t i_ ) { return 1.0 + double ( i_ % 1'000 ); };
+    jsf64 rng;
+    plf::nanotimer timer;
+    timer.start ( );
+    std::vector<std::pair<double, std::uint64_t>> heap;
+    for ( std::uint64_t i = 0; i < n; ++i ) {
+        const double key = std::log ( double ( ( rng ( ) >> 11 ) + 1 ) * 0x1p-53 ) / weight ( i );
+        if ( heap.size ( ) < k_ or key > heap.front ( ).first ) {
+            if ( heap.size ( ) == k_ )
+                std::pop_heap ( heap.begin ( ), heap.end ( ), std::greater<> ( ) ), heap.pop_back ( );
+            heap.emplace_back ( key, i );
+            std::push_heap ( heap.begin ( ), heap.end ( ), std::greater<> ( ) );
+        }
+    }
+    const double keyed = timer.get_elapsed_ns ( ) / n;
+    timer.start ( );
+    weighted_reservoir<std::uint64_t, jsf64> reservoir ( k_, 1 );
+    for ( std::uint64_t i = 0; i < n; ++i )
+        reservoir.push ( i, i, weight ( i ) );
+    const double jumps = timer.get_elapsed_ns ( ) / n;
+    std::vector<std::uint64_t> items ( n );
+    std::iota ( items.begin ( ), items.end ( ), std::uint64_t{ 0 } );
+    timer.start ( );
+    const auto sample    = rng::weighted_sample<jsf64> ( std::execution::par, items.begin ( ), items.end ( ), k_, 1, weight );
+    const double sharded = timer.get_elapsed_ns ( ) / n;
+    std::cout << "k = " << k_ << std::string ( k_ < 1'000 ? 3 : 2, ' ' ) << keyed << " ns A-Res  " << jumps << " ns A-ExpJ  " << sharded
+              << " ns weighted_sample ( " << ( sample.size ( ) == reservoir.sample ( ).size ( ) and
+                                                 sample.front ( ).index == reservoir.sample ( ).front ( ).index ? "same" : "differs" )
+              << " )" << nl;
+}
+
+// The root mean square error, over 16 replicates, of the integral of Sobol's
+// g-function ( exactly 1 ) in dims_ dimensions from 2^10 .. 2^18 points, jsf64
+// against the Owen-scrambled Sobol sequence, and ns per coordinate of the fill.
+void bench_sobol ( const std::size_t dims_ ) {
+    constexpr int replicates = 16;
+    const auto g             = [ dims_ ] ( const double * x_ ) {
+        double p = 1.0;
+        for ( std::size_t d = 0; d < dims_; ++d )
+            p *= ( std::abs ( 4.0 * x_[ d ] - 2.0 ) + double ( d * d ) ) / ( 1.0 + double ( d * d ) );
+        return p;
+    };
+    std::cout << "d = " << dims_ << nl;
+    for ( int m = 10; m <= 18; m += 4 ) {
+        const std::size_t n = std::size_t{ 1 } << m;
+        std::vector<double> points ( n * dims_ );
+        double pseudo = 0.0, quasi = 0.0, pseudo_ns = 0.0, quasi_ns = 0.0;
+        plf::nanotimer timer;
+        for ( int r = 0; r < replicates; ++r ) {
+            jsf64 rng ( r );
+            timer.start ( );
+            for ( double & x : points )
+                x = double ( rng ( ) >> 11 ) * 0x1p-53;
+            pseudo_ns += timer.get_elapsed_ns ( );
+            double sum = 0.0;
+            for ( std::size_t i = 0; i < n; ++i )
+                sum += g ( points.data ( ) + i * dims_ );
+            pseudo += ( sum / n - 1.0 ) * ( sum / n - 1.0 );
+            sobol sequence ( dims_, rng );
+            timer.start ( );
+            rng::fill_points ( std::execution::par, sequence, points );
+            quasi_ns += timer.get_elapsed_ns ( );
+            sum = 0.0;
+            for ( std::size_t i = 0; i < n; ++i )
+                sum += g ( points.data ( ) + i * dims_ );
+            quasi += ( sum / n - 1.0 ) * ( sum / n - 1.0 );
+        }
+        const double coordinates = double ( replicates ) * points.size ( );
+        std::cout << "n = 2^" << m << "  rmse " << std::sqrt ( pseudo / replicates ) << " jsf64  " << std::sqrt ( quasi / replicates )
+                  << " sobol  ( " << pseudo_ns / coordinates << " / " << quasi_ns / coordinates << " ns per coordinate )" << nl;
+    }
+}
+
+// Time to accuracy: for each sampler, the fewest points ( doubling, or the next
+// strata^dims_ grid ) at which the estimates of the integral of exp ( sum_d x_d
+// / ( d + 1 ) ) over [ 0, 1 )^dims_ have a relative RMS error, over 32
+// replicates, below target_, and the time an estimate ( sampling and
+// evaluation ) takes at that size; jsf64 throughout, up to 2^22 points.
+void bench_variance ( const std::size_t dims_, const double target_ ) {
+    constexpr int replicates      = 32;
+    constexpr std::size_t largest = std::size_t{ 1 } << 22;
+    double exact                  = 1.0;
+    for ( std::size_t d = 0; d < dims_; ++d )
+        exact *= std::expm1 ( 1.0 / double ( d + 1 ) ) * double ( d + 1 );
+    std::vector<double> points;
+    const auto estimate = [ & ] ( const std::size_t n_ ) {
+        double sum = 0.0;
+        for ( std::size_t i = 0; i < n_; ++i ) {
+            double e = 0.0;
+            for ( std::size_t d = 0; d < dims_; ++d )
+                e += points[ i * dims_ + d ] / double ( d + 1 );
+            sum += std::exp ( e );
+        }
+        return sum / double ( n_ );
+    };
+    const auto run = [ & ] ( const char * name_, const auto size_, const auto sample_ ) {
+        std::cout << "  " << name_;
+        for ( std::size_t step = 1;; ++step ) {
+            const std::size_t n = size_ ( step );
+            if ( n > largest ) {
+                std::cout << "not reached" << nl;
+                return;
+            }
+            points.resize ( n * dims_ );
+            double error = 0.0, ns = 0.0;
+            plf::nanotimer timer;
+            for ( int r = 0; r < replicates; ++r ) {
+                jsf64 rng ( r );
+                timer.start ( );
+                sample_ ( rng, step );
+                const double e = estimate ( n ) / exact - 1.0;
+                ns += timer.get_elapsed_ns ( );
+                error += e * e;
+            }
+            if ( std::sqrt ( error / replicates ) < target_ ) {
+                std::cout << n << " points  " << ns / ( 1'000.0 * replicates ) << " us" << nl;
+                return;
+            }
+        }
+    };
+    const auto doubling = [] ( const std::size_t step_ ) { return std::size_t{ 8 } << step_; };
+    std::cout << "d = " << dims_ << "  relative rmse < " << target_ << nl;
+    run ( "independent      ", doubling, [ & ] ( jsf64 & rng_, std::size_t ) {
+        block_buffer<jsf64> source ( rng_ );
+        for ( double & x : points )
+            x = double ( source ( ) >> 11 ) * 0x1p-53;
+    } );
+    run ( "antithetic       ", doubling, [ & ] ( jsf64 & rng_, std::size_t ) { antithetic ( rng_, dims_, points ); } );
+    run (
+        "stratified       ",
+        [ & ] ( const std::size_t step_ ) {
+            double n = std::pow ( double ( step_ + 1 ), double ( dims_ ) );
+            return n > double ( largest ) ? largest + 1 : std::size_t ( n );
+        },
+        [ & ] ( jsf64 & rng_, const std::size_t step_ ) { stratified ( rng_, dims_, step_ + 1, points ); } );
+    run ( "latin hypercube  ", doubling,
+          [ & ] ( jsf64 & rng_, std::size_t ) { rng::latin_hypercube ( std::execution::par, rng_, dims_, points ); } );
+    run ( "scrambled sobol  ", doubling, [ & ] ( jsf64 & rng_, std::size_t ) {
+        sobol sequence ( dims_, rng_ );
+        rng::fill_points ( std::execution::par, sequence, points );
+    } );
+}
+
+// gmp_random bench <what>
+//
+// tempering: the cost per block of rxs_m_xs_output over raw_output.
+// lanes:     mpn_mul against lehmer_lanes, ns per value.
+// gf2:       GMPRng2 against gf2_lehmer, ns per value.
+// construct: GMPRng2 construction, ns.
+// huge:      mpn_mul_n against ntt_mul and GMPRngHuge, us, S = 2^10 .. 2^20.
+// retreat:   generate against generate_backward, ns per value.
+// sparse:    Bernoulli trials, a draw per trial against geometric skips, ms.
+// bernoulli: Bernoulli bitmasks, a draw per bit against bernoulli_bits, ns.
+// zipf:      Zipf keys, rejection-inversion and alias table, ns per key.
+// reservoir: weighted reservoir sampling, A-Res against A-ExpJ, ns per item.
+// sobol:     integration error, jsf64 against scrambled Sobol points.
+// variance:  time to accuracy of independent, antithetic, stratified, latin
+//            hypercube and scrambled Sobol points.
+// async:     a coroutine awaiting async_block_source blocks against
+//            fill_block, ns per value.
+// stream:    nontemporal fill_block against the plain one, jsf64 and
+//            GMPRng2<64>, into a buffer of argv[ 3 ] (512) MiB.
+int bench_main ( int argc, char ** argv ) {
+    if ( argc < 3 ) {
+        std::cerr << "usage: gmp_random bench tempering|lanes|gf2|construct|huge|retreat|sparse|bernoulli|zipf|reservoir|sobol|variance|async|stream [<MiB>]" << nl;
+        return EXIT_FAILURE;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "construct" ) ) {
+        bench_construct<4> ( );
+        bench_construct<16> ( );
+        bench_construct<64> ( );
+        bench_construct<256> ( );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "retreat" ) ) {
+        bench_retreat<jsf64> ( "jsf64" );
+        bench_retreat<jsf32> ( "jsf32" );
+        bench_retreat<mcg128> ( "mcg128" );
+        bench_retreat<mcg128_fast> ( "mcg128_fast" );
+        bench_retreat<GMPRng2<4, 1>> ( "GMPRng2<4, 1>" );
+        bench_retreat<GMPRng2<16, 1>> ( "GMPRng2<16, 1>" );
+        bench_retreat<GMPRng2<64, 1>> ( "GMPRng2<64, 1>" );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "async" ) ) {
+        bench_async<jsf64> ( "jsf64      " );
+        bench_async<GMPRng2<64>> ( "GMPRng2<64>" );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "variance" ) ) {
+        bench_variance ( 4, 1e-2 );
+        bench_variance ( 4, 1e-3 );
+        bench_variance ( 4, 1e-4 );
+        bench_variance ( 16, 1e-3 );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "sobol" ) ) {
+        bench_sobol ( 4 );
+        bench_sobol ( 32 );
+        bench_sobol ( 256 );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "reservoir" ) ) {
+        bench_reservoir ( 10 );
+        bench_reservoir ( 1'000 );
+        bench_reservoir ( 10'000 );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "zipf" ) ) {
+        bench_zipf ( 0.5 );
+        bench_zipf ( 0.8 );
+        bench_zipf ( 0.99 );
+        bench_zipf ( 1.0 );
+        bench_zipf ( 1.2 );
+        bench_zipf ( 2.0 );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "bernoulli" ) ) {
+        bench_bernoulli ( 0.5 );
+        bench_bernoulli ( 0.3 );
+        bench_bernoulli ( 1.0 / 3.0 );
+        bench_bernoulli ( 0.01 );
+        bench_bernoulli ( 1e-6 );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "sparse" ) ) {
+        bench_sparse ( 1e-1 );
+        bench_sparse ( 1e-2 );
+        bench_sparse ( 1e-3 );
+        bench_sparse ( 1e-4 );
+        bench_sparse ( 1e-5 );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "huge" ) ) {
+        bench_huge<std::size_t{ 1 } << 10> ( );
+        bench_huge<std::size_t{ 1 } << 12> ( );
+        bench_huge<std::size_t{ 1 } << 14> ( );
+        bench_huge<std::size_t{ 1 } << 16> ( );
+        bench_huge<std::size_t{ 1 } << 18> ( );
+        bench_huge<std::size_t{ 1 } << 20> ( );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "stream" ) ) {
+        const std::size_t mib = argc > 3 ? std::strtoull ( argv[ 3 ], nullptr, 10 ) : 512;
+        std::cout << "jsf64" << nl;
+        bench_stream<jsf64> ( mib );
+        std::cout << "GMPRng2<64>" << nl;
+        bench_stream<GMPRng2<64>> ( mib );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "gf2" ) ) {
+        bench_gf2<2> ( );
+        bench_gf2<4> ( );
+        bench_gf2<8> ( );
+        bench_gf2<16> ( );
+        bench_gf2<32> ( );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "lanes" ) ) {
+        bench_lanes<4> ( );
+        bench_lanes<8> ( );
+        bench_lanes<16> ( );
+        bench_lanes<32> ( );
+        bench_lanes<64> ( );
+        return EXIT_SUCCESS;
+    }
+    if ( not std::strcmp ( argv[ 2 ], "tempering" ) ) {
+        bench_tempering<4> ( );
+        bench_tempering<16> ( );
+        bench_tempering<64> ( );
+        bench_tempering<256> ( );
+        return EXIT_SUCCESS;
+    }
+    std::cerr << "unknown benchmark: " << argv[ 2 ] << nl;
+    return EXIT_FAILURE;
+}
+
+// gmp_random cpu
+//
+// Prints the features of the host and, for each kernel, its variants, the
+// selected one marked * (set GMP_RANDOM_FORCE=<variant> to force one).
+int cpu_main ( int, char ** ) {
+    const cpu_features & c = cpu_features::host ( );
+    std::cout << "pclmul " << c.pclmul << nl << "avx " << c.avx << nl << "avx2 " << c.avx2 << nl << "bmi2 " << c.bmi2 << nl
+              << "adx " << c.adx << nl << "avx512f " << c.avx512f << nl << "avx512dq " << c.avx512dq << nl << "vpclmulqdq "
+              << c.vpclmulqdq << nl;
+    ( void ) gf2_detail::clmul ( );
+    ( void ) rxs_m_xs_output::kernel ( );
+    lehmer_lanes<16> ( ).advance ( );
+    dispatch::print ( std::cout );
+    return EXIT_SUCCESS;
+}
+
+int run_command ( int argc, char ** argv ) {
+    if ( not std::strcmp ( argv[ 1 ], "search-multipliers" ) )
+        return search_multipliers_main ( argc, argv );
+    if ( not std::strcmp ( argv[ 1 ], "autotune" ) )
+        return autotune_main ( argc, argv );
+    if ( not std::strcmp ( argv[ 1 ], "stats" ) )
+        return stats_main ( argc, argv );
+    if ( not std::strcmp ( argv[ 1 ], "serve" ) )
+        return serve_main ( argc, argv );
+    if ( not std::strcmp ( argv[ 1 ], "client" ) )
+        return client_main ( argc, argv );
+    if ( not std::strcmp ( argv[ 1 ], "streams" ) )
+        return streams_main ( argc, argv );
+    if ( not std::strcmp ( argv[ 1 ], "bench" ) )
+        return bench_main ( argc, argv );
+    if ( not std::strcmp ( argv[ 1 ], "cpu" ) )
+        return cpu_main ( argc, argv );
+    std::cerr << "unknown command: " << argv[ 1 ] << nl;
+    return EXIT_FAILURE;
+}
+
 #if 1
 
-int main ( ) {
+int main ( int argc, char ** argv ) {
+
+    if ( argc > 1 )
+        return run_command ( argc, argv );
 
     Generator prng;
 
@@ -488,15 +1756,13 @@ int main ( ) {
 
 #else
 
-#    ifdef _WIN32 // needed to allow binary stdout on windows
-#        include <fcntl.h>
-#        include <io.h>
-#    endif
-
 #    include <cstdint>
 #    include <iostream>
 
-int main ( ) {
+int main ( int argc, char ** argv ) {
+
+    if ( argc > 1 )
+        return run_command ( argc, argv );
 
 #    ifdef _WIN32 // Needed to allow binary stdout on Windhoze...
     _setmode ( _fileno ( stdout ), _O_BINARY );
@@ -0,0 +1,129 @@
+
+// Generated by `gmp_random search-multipliers 2048 8 1 2 4:256 8:256 16:32 32:32 64:32`, do not edit.
+//
+// vetted_multipliers<Limbs>::value holds multipliers of Limbs limbs, sorted by
+// their spectral test figure of merit (dimensions 2 .. 8) for the modulus
+// 2^( 64 * Limbs ), best first.
+
+#pragma once
+
+#include <cstddef>
+
+#include <gmpxx.h>
+
+template<std::size_t Limbs>
+struct vetted_multipliers {
+    static constexpr std::size_t size = 0;
+};
+
+template<>
+struct vetted_multipliers<1> {
+    static constexpr std::size_t size = 8;
+    static constexpr double merit[ size ] = { 0.661028, 0.646185, 0.642955, 0.637551, 0.637495, 0.637247, 0.632891, 0.629924 };
+    static constexpr mp_limb_t value[ size ][ 1 ] = {
+        { 0xc31694e7efa86c0dULL },
+        { 0x069ac79654c0a6c5ULL },
+        { 0xb9ab8fd9e98ab96dULL },
+        { 0x6163f7f8a8f7441dULL },
+        { 0xebd87380785be22dULL },
+        { 0x3e48666b2c13b0fdULL },
+        { 0x9ef745685e038dd5ULL },
+        { 0x0a645d3a5b14c975ULL },
+    };
+};
+
+template<>
+struct vetted_multipliers<2> {
+    static constexpr std::size_t size = 8;
+    static constexpr double merit[ size ] = { 0.713836, 0.702789, 0.673689, 0.662013, 0.653132, 0.653013, 0.65283, 0.645121 };
+    static constexpr mp_limb_t value[ size ][ 2 ] = {
+        { 0x0506c7b41c194b3dULL, 0x667c64dcdb8bfbc2ULL },
+        { 0x04773a9d14333ed5ULL, 0xa375a6d6d08538e3ULL },
+        { 0xa3d1e82e868c04e5ULL, 0xe52fae4d05387ec7ULL },
+        { 0x79bb216298b6539dULL, 0x0b66559a66dccc94ULL },
+        { 0x6c3a6de6a5b9c98dULL, 0x9b93586eb305d94dULL },
+        { 0x59bbbffe1e9cb85dULL, 0x75e00fcce3e8ab70ULL },
+        { 0xa406ea08e4844e0dULL, 0x901005d2332b918aULL },
+        { 0x50a1a45719aa6e6dULL, 0x3a910dc84d5b71b9ULL },
+    };
+};
+
+template<>
+struct vetted_multipliers<4> {
+    static constexpr std::size_t size = 8;
+    static constexpr double merit[ size ] = { 0.613536, 0.609955, 0.607975, 0.592999, 0.589993, 0.582091, 0.579264, 0.57611 };
+    static constexpr mp_limb_t value[ size ][ 4 ] = {
+        { 0x51a0ee13f9317d9dULL, 0xdae47de2f1ac4547ULL, 0x1a4df045465f67c7ULL, 0xd991b9b9eeb49d18ULL },
+        { 0x02dcc6ffa6b5f735ULL, 0x533f1c42bb944cd5ULL, 0x18eec546aa789ffbULL, 0xdb516d8672dba8c5ULL },
+        { 0xa11a90241483811dULL, 0xfde572348d36fd4fULL, 0x9d82ab20136dfb0cULL, 0x31da2016e283e0caULL },
+        { 0xbcd2e3cab7ff6475ULL, 0x4554af9bdf7fdc79ULL, 0x657ee84a9aaa6c2fULL, 0xedffb3501075efe8ULL },
+        { 0x56b13818f5ecb735ULL, 0x76a1a66f9ee404e8ULL, 0x30892ea0643d6902ULL, 0x65c7e39d938b4821ULL },
+        { 0x7416fada3946dde5ULL, 0xb9dc2d3ffcb3d86eULL, 0x82fa1e27fe9aaf9dULL, 0x42a86d1856903b10ULL },
+        { 0x584f7819c11a8965ULL, 0xc5cfd05485a05d5aULL, 0x65a920096a0044b5ULL, 0x71c4cd6fcf1cdadcULL },
+        { 0x5b2b5893975c6a45ULL, 0x95e9a00100af86c6ULL, 0xddda939daea86d76ULL, 0xb1d61fc03f41dd88ULL },
+    };
+};
+
+template<>
+struct vetted_multipliers<8> {
+    static constexpr std::size_t size = 8;
+    static constexpr double merit[ size ] = { 0.66096, 0.655894, 0.621324, 0.615741, 0.601505, 0.596874, 0.594198, 0.593568 };
+    static constexpr mp_limb_t value[ size ][ 8 ] = {
+        { 0x4823b6793ae35d65ULL, 0xcfb0c9c780ddd796ULL, 0xf32d037bfc962e3cULL, 0x2fe743e75cf93f03ULL, 0x0f5c04a0fd1a0a12ULL, 0xd61640969b60845dULL, 0xad04f640aa1dcdc0ULL, 0x1ff5dacc9c6f2077ULL },
+        { 0x263c68410db4f37dULL, 0xae4a13022a86316cULL, 0x97a51456c59036ebULL, 0x729910fb6c700dc9ULL, 0x71dbf45027a99282ULL, 0x8c331e66f90a9f11ULL, 0x5bc3e96615b94e79ULL, 0xaa6e2f0efad5d542ULL },
+        { 0xb5c61ce3edd28e65ULL, 0xa40750835d8d3c80ULL, 0x8f5ef73117c3d720ULL, 0x88b63003c7279ecdULL, 0xd2a8e39f7a05143cULL, 0xa8f56aa471fef317ULL, 0x1c1862e6c539f326ULL, 0xc795dd13b7b68c21ULL },
+        { 0x888d2ae2c9fc9e6dULL, 0x38ec44006fe6023cULL, 0xa8aa33dc3eb47351ULL, 0xe399663e5cbb82d5ULL, 0x92ebf7807326ac98ULL, 0x715dc58e303a8aa1ULL, 0x66b8a8a2183d6774ULL, 0xc8b62dae797f45ecULL },
+        { 0xeef06d480b2f2225ULL, 0x5770b7f0a635a96aULL, 0x933d3c604eb38868ULL, 0xfa347980797b2827ULL, 0x79b044a76350d18fULL, 0x2a877b024d071738ULL, 0x3446d5c5355fa2e3ULL, 0xf75dd4304ad39a47ULL },
+        { 0xfa5b045fe308076dULL, 0x067eb283b11325d1ULL, 0xd75ec8c9cbffd40bULL, 0x64fa9fdc7ea82f40ULL, 0x0b2b822102d4c25eULL, 0xe3ef1bc5b5365fecULL, 0xf4cdd01971ed0c1dULL, 0x633eac280865514eULL },
+        { 0x4017fdd10d0709c5ULL, 0x76554633d956ac95ULL, 0xf0c7137df85e630fULL, 0x1fc495ae1a0ccd27ULL, 0xeb7a2227151df862ULL, 0xc4d1c94516fd1a2dULL, 0xf68d10084fc6c03bULL, 0x2a098db628ed67a2ULL },
+        { 0x52e52f2e193f6425ULL, 0x28eaa13113a79c8dULL, 0x7901182b04d4a51cULL, 0x19f8e1d73ebd49f5ULL, 0x5699800ae3ba4d1dULL, 0xdc4b099cace30885ULL, 0x1883a39446fa6012ULL, 0xc07ed8fed4d3b6d3ULL },
+    };
+};
+
+template<>
+struct vetted_multipliers<16> {
+    static constexpr std::size_t size = 8;
+    static constexpr double merit[ size ] = { 0.606496, 0.572771, 0.570035, 0.564201, 0.563748, 0.559026, 0.477262, 0.457473 };
+    static constexpr mp_limb_t value[ size ][ 16 ] = {
+        { 0x3a1dffc2b9c627b5ULL, 0xa722130af832a923ULL, 0x65afa4e818f20701ULL, 0x127b5c18b77fcf8cULL, 0xde247b3931e2217fULL, 0x93eba20492a002bcULL, 0xdf5cd5d62c06398fULL, 0x6f8e50619ac01753ULL, 0x773b7a42ffa3b3e9ULL, 0x4777391b955e3205ULL, 0x96015e7b38bd258aULL, 0xa3d6726c447b1eacULL, 0x1f9089296845330aULL, 0x1d3d1e4a57679e75ULL, 0xfeeaa238196c4345ULL, 0xd97fb1db43b1ab71ULL },
+        { 0x51a26ecc35ec8665ULL, 0x12e6e4cf32fa2b6eULL, 0xfba247e310d80227ULL, 0xee0dabb38f98ccc7ULL, 0x76525c2bb2aafa18ULL, 0x19cf9788a82af883ULL, 0x8ed72226763b0e27ULL, 0x0e037f88eb61f780ULL, 0x9e0f325fef7cfd75ULL, 0x4d6af629de7c665fULL, 0x6db5965a15a756c3ULL, 0x55673b29bd5ac2c3ULL, 0xfd51e9391ff8bf4cULL, 0xcd4d22c08f9611edULL, 0xcba5a5bf06c79805ULL, 0x9b285b66a21af6e7ULL },
+        { 0xcc8f7170e6f4885dULL, 0xa4ec540ba16272c7ULL, 0x439720e1a45edd61ULL, 0x765483d1236bfddfULL, 0x75300bbeabcd0ed3ULL, 0x9c171c586d142853ULL, 0x32c0932f4a060c5dULL, 0x0f66117475f72556ULL, 0x7d3108fbe3e302f7ULL, 0xb959622a0a88fa0cULL, 0x08125f5682a9a30fULL, 0x86259eb6cef7db06ULL, 0x426f22723d73da4cULL, 0x285f11325b340cd8ULL, 0x63b4fc4aadf7009aULL, 0x723a616b4affb56aULL },
+        { 0xf9a90003e05226bdULL, 0x1b8b5c7ee621a914ULL, 0xc087bcd68ab4063dULL, 0xb528bf85be795e55ULL, 0xe345e43c7be442cfULL, 0x0975f3bb8a5fc11cULL, 0x95d012b966323c07ULL, 0x3808a264b7af2635ULL, 0xfe9dd62a03b3ce5aULL, 0xdde59088b4a978fcULL, 0xa76c2c868f5d465cULL, 0xf8709e806355cd7aULL, 0x1a9ec6f769676d61ULL, 0x93167d22e3e2bd7eULL, 0xf12d9b57a8241db5ULL, 0xb49beb5254452468ULL },
+        { 0x5ac9d00afd3d1a95ULL, 0xb2f970dfe3b6eb9dULL, 0xe11fbbc9dabb64fcULL, 0x176040816086b878ULL, 0xdf1d154d265df777ULL, 0xe57d418667e04ce1ULL, 0xa37a3490ac1ddecdULL, 0xe52d1b72ceb2afcfULL, 0xf2beb0410eb3c2a7ULL, 0xef0159ed55d0c58dULL, 0xce43384c9db2a329ULL, 0xb772c52fc9c1ce1aULL, 0x5435a5ff41c33561ULL, 0xb51b76da85e1e849ULL, 0x308f293fec9873d4ULL, 0xfbb41c3bb9c8bc0fULL },
+        { 0xf1b2f65dfb103265ULL, 0xa4021869d388483bULL, 0x59ba6387ac54a8cbULL, 0x77e5d621bea3d506ULL, 0x97d77fcdddf4d10cULL, 0xcf6675bdd9b8b207ULL, 0x9d87bf18788b4898ULL, 0xb103cbc226c8b856ULL, 0xd9394d5f4b5f07e7ULL, 0x967deaa1751b6a23ULL, 0x0353fe6077a7ded2ULL, 0x20f5d21f80cedacaULL, 0x726aa644e77b6b61ULL, 0xbb7e35f92b49bd68ULL, 0x3596d6e6b34f391cULL, 0xfbd54ad3f88b94a6ULL },
+        { 0x23f4cb89978a44b5ULL, 0x9717188b8b5d3a67ULL, 0x9bb1b79b74baa8deULL, 0x48855d80b00f4ca3ULL, 0xdf8e9758e9d9d2a5ULL, 0x2bae413014633881ULL, 0xde18af29ff8640d0ULL, 0x9b091d7755aeca14ULL, 0x8ace48719a14aa6cULL, 0x70eecae5eb329075ULL, 0x1cf8e4af185096a9ULL, 0x0e7a9bf35f0179bcULL, 0xc242306e88eab094ULL, 0x5c6fafe719e9ea47ULL, 0x0f229b98a53fa6c0ULL, 0x35ca1728b342ff2bULL },
+        { 0xa770478a31ce15f5ULL, 0x7d02f1cbf219553aULL, 0x8d07b2afc1a337a2ULL, 0x6385c97069e3c49aULL, 0x0ea4dcfa3fbcbc3bULL, 0x452ca116979b6a0dULL, 0x38f8e1b207a76566ULL, 0x2ed510891c9a42b0ULL, 0x701c9578730b2b01ULL, 0xcfd5e24a26fbbbd7ULL, 0x3f87182d7df554cfULL, 0x1c30632d7783fe5bULL, 0x6002ec1756d75f1fULL, 0x49cc9087dba61da9ULL, 0x48791afd2f209a8aULL, 0xf90b39d51f2460f4ULL },
+    };
+};
+
+template<>
+struct vetted_multipliers<32> {
+    static constexpr std::size_t size = 8;
+    static constexpr double merit[ size ] = { 0.624954, 0.613177, 0.573902, 0.55073, 0.505467, 0.482653, 0.482003, 0.478607 };
+    static constexpr mp_limb_t value[ size ][ 32 ] = {
+        { 0x3fb5401c35e9ff5dULL, 0x6f674d88386ee5d1ULL, 0xbab20d7573e4a397ULL, 0x91eeeddc2cedae6dULL, 0xadb897fa09bcc563ULL, 0xfe544d28c0e6ec0aULL, 0xe170e3c7276868eeULL, 0xbbdba6d355234a21ULL, 0x34103bdc807ef62bULL, 0xdd9e90fcc3444493ULL, 0x086331902d9cde4cULL, 0x318649114c3cfb57ULL, 0x50df50c27fe5f289ULL, 0x7ae5c8d01bfe7d05ULL, 0x41af8201811b2cc0ULL, 0x72fbfdda65692e71ULL, 0x2ae38b5fd4e2bfd0ULL, 0x0147cdf61479cc6bULL, 0x6d3c2441a149d820ULL, 0xe0d08b3fd36c170bULL, 0x8405140b1795c16bULL, 0x6e3501f39829b15aULL, 0xd401e50ec5ec7627ULL, 0x389decd72f2386bcULL, 0xb2e73ed180275c5fULL, 0x09603788138c6604ULL, 0x6df5ed840742728bULL, 0xdb60a8921938ee2dULL, 0x4dcc2848e18c058eULL, 0x733de9ad5074fb2cULL, 0xa0c6bfe5a40b15f8ULL, 0x0990fa9ae12c1af0ULL },
+        { 0xf3288cd6c853be7dULL, 0xb05e10cfe7006c8fULL, 0x4609752bd5b4adb6ULL, 0x069a559980286addULL, 0xe0321d60a8f231d6ULL, 0x9f63e45f5e4b4243ULL, 0x486e49d5a8fa5931ULL, 0xa980cd0604e518e3ULL, 0x94b6a0c74d9fada7ULL, 0x2b6ad15844b2ef7cULL, 0x9c60d54581f4a387ULL, 0x7d2eb5874c665c49ULL, 0xfbfeb0e6cce45baeULL, 0x4f69f26d7dd4399eULL, 0x104efed4bc2d9ab9ULL, 0xec29904f8203d195ULL, 0x1578a6ce0837cad7ULL, 0xebd9059cef99e24cULL, 0x01248943f883abf7ULL, 0x8c40683c75a0af2fULL, 0x71726c400fac5f27ULL, 0xe345f18de47b2d03ULL, 0xffc78a02aae63b2fULL, 0x0ecc7e1226339b25ULL, 0xc101a722dfe0b3baULL, 0xafa1e2f02b8f39e9ULL, 0xf16f4d89b6f0fab6ULL, 0x3d3d2087191ffa58ULL, 0x73bc0291f3b28459ULL, 0x1d23bf24d1bda4cbULL, 0xb0921e4d2377bf34ULL, 0x09231327386b8b98ULL },
+        { 0x635c9fb713ff1705ULL, 0x15bcbb67fbc02be0ULL, 0x697384dd769709f0ULL, 0xa672980bbdfb3a4fULL, 0xf1c919dc3f168926ULL, 0xb00041b99e855b49ULL, 0x157fca0454dc52afULL, 0x8e392ce20cae8e18ULL, 0xb1f4a6343868817cULL, 0xd9e536d988468c23ULL, 0x5555304508bff1deULL, 0x74910323e2b8ab8eULL, 0xf045fb2e7562051aULL, 0x2894bd908da98d15ULL, 0x23919112cff85723ULL, 0xa1973f7aa734b0c0ULL, 0x5dc84f4ac33f2199ULL, 0x35ecc5e2d85ec77fULL, 0xcc641fbf03cea533ULL, 0x71bf4b84464f7113ULL, 0xa2b7e875f605f27bULL, 0xbea7053ccd7f406aULL, 0x325e3c1532f56914ULL, 0xfcb99bf6a2b0fe69ULL, 0x7ef323fe9ddad047ULL, 0x5cc3c77259480f5cULL, 0x5146d63833bb27efULL, 0xa861fb283fb3c15fULL, 0x07acc6344cd9f2beULL, 0xbe2ffcf55c3a847cULL, 0x69bb0ec72f795f77ULL, 0x9fd1cece6f74a3a9ULL },
+        { 0x656b5772e00325edULL, 0xc5b40ce2578f9e43ULL, 0x1cc99ed50e9c1b69ULL, 0x00ffbece87f533d4ULL, 0x88b2df91d9b65b5bULL, 0xb6a989b09b93bfa6ULL, 0x82eda1f89410e7e4ULL, 0x2ec4a7c23abd6577ULL, 0x39043d0912aa0a14ULL, 0xd435e840a36e4829ULL, 0xbde80a02208a168aULL, 0x931b60846bbfb908ULL, 0x850d36b44baf0b85ULL, 0xf6737ce913df0237ULL, 0x3af250a71a12275eULL, 0xeff667091020bfc1ULL, 0x39d13e1be32976ceULL, 0x467d58659581b40dULL, 0x1df424ab30a8458aULL, 0xc8b3458f1afb6c17ULL, 0x0b9c018dec2e3253ULL, 0x14113b067ecceccdULL, 0xfd07aa341d6b398fULL, 0xe978759209e6a98bULL, 0x3cb81eb523afa7cbULL, 0x69d8ed6e32eaddecULL, 0xb971cd22779ce4d1ULL, 0xd4e6dac1d574563dULL, 0xd1bd76f0e762762eULL, 0x2fce581d989f8be6ULL, 0x29b692acdfade8afULL, 0x269a73c4a1e0400fULL },
+        { 0x0a87c53371b3d455ULL, 0x5a0276a98a21dd6bULL, 0xc41d13c06ee12c47ULL, 0x11f87d2c32668bf8ULL, 0xc56ec7b7c337897fULL, 0xe58faee001f63d3eULL, 0x1656fd3cf6600a4cULL, 0xec771ef19df6a5afULL, 0x4106d8e9f4c041f2ULL, 0xeb20af439c8a2f93ULL, 0x6780f61ccbada02aULL, 0xeabb3d1030ddba59ULL, 0xfdb7f417272da9faULL, 0xf4ccdc68a135624cULL, 0x2c8c45ae7eaa6fd6ULL, 0xa8dedb0255314fd0ULL, 0x2811c4807cf30c55ULL, 0xa7caab9552ae999eULL, 0x5ab85dda5e02a40bULL, 0xb47b850baeab3b0fULL, 0x24805b7b6ad6fe96ULL, 0xe67c9fef9d8405feULL, 0xad02b589546881e6ULL, 0x5bf4f21424424c9bULL, 0xd5cc25857502ab06ULL, 0x4f379f3b889d7685ULL, 0xa5460b66bcb41f5dULL, 0xb27d77bec32a84cdULL, 0xe5ebd1326d00547dULL, 0x6e32a2faaf495a7fULL, 0x2885c9f396abc8dbULL, 0x2bb0ab2b37d1b382ULL },
+        { 0x4a8c950a3835ff45ULL, 0x7d25d94f2020f14bULL, 0xc9ab729007c84130ULL, 0x0c19a484409d8f4eULL, 0xad88736f27124676ULL, 0x3f170f5134999c2eULL, 0x68a5482236a56ac9ULL, 0x8b747dc881389322ULL, 0xcf8eafc9187563cbULL, 0x20f8aaef4ce972abULL, 0x156703d8bf07949aULL, 0xae97f67f8852e489ULL, 0xbde00279d989118fULL, 0xf20b0eee4bf6def5ULL, 0x048867dbdea85780ULL, 0xc14505359a55d587ULL, 0x412ef9c913aee8deULL, 0x39b655406af7fdd2ULL, 0xe8879d64ea796e3aULL, 0x4510329df105898aULL, 0xf922eee4557e5d10ULL, 0xf62c39d00c1c4e56ULL, 0xf8bb6cd1af1a4baeULL, 0xc4e9d51e720eb749ULL, 0x636e79db8e3f69ddULL, 0x8f48d3b0f967febbULL, 0x296ccfbdf002c8ebULL, 0x8d23960217244951ULL, 0x59d24b30ddc09cc2ULL, 0x716c35eaa0e0695fULL, 0x0e252d01a12cea0dULL, 0x2aaf14c64d02ee77ULL },
+        { 0x8f20956a1c909905ULL, 0x6b0fa5fedda87a91ULL, 0x6684953631cd1aa4ULL, 0x828aea6664d6cc16ULL, 0x7f19c2c5da27c0bdULL, 0xe374e118d6cc656fULL, 0x83a07bc5fa5a32f8ULL, 0x2f091d8ac0f41746ULL, 0xb733c06a465b4fdeULL, 0x018f7db1d1dd594aULL, 0xf738d8c80196eb20ULL, 0x2563f220edba5818ULL, 0x0f667f260baa8191ULL, 0x32e6f982b6630dc0ULL, 0xd7e709851983be19ULL, 0x0b6b1a84dca4b255ULL, 0x632bb01e0b9b1978ULL, 0x9d7e41c2054740c3ULL, 0xfba284f9c5cbf419ULL, 0x321e3f9b64c7547bULL, 0xcd099b1a5e3a8037ULL, 0x7a49d45fcc52aca1ULL, 0x27977d90d0da183aULL, 0x67c24b8f26e5f986ULL, 0xa76d533f971a02f8ULL, 0xcbb67e1280fb4e60ULL, 0x878d12a5c2852e73ULL, 0x746bdc1f533738a0ULL, 0xb8bf99b0ed03f463ULL, 0x46c0e87b6b95439bULL, 0x487d0cf1b443635eULL, 0x8516a3eb89376971ULL },
+        { 0x5c3fc9e8e436803dULL, 0x58f0649b059bfcc2ULL, 0x4f6927abc8b3ebd4ULL, 0x882a09478e813a93ULL, 0xb3887c4a0cb08009ULL, 0x9d08ca4aeec2a972ULL, 0x35bb9a914e68c4f3ULL, 0xd7d81367573c550aULL, 0x1201376daca6abbcULL, 0x9850e99a1d1b93dcULL, 0x3ae3b272ef7ce344ULL, 0x7ce9b0061f5afe07ULL, 0x179477c03cf51505ULL, 0x44cc475df05178baULL, 0xecea6c5825dd6ed9ULL, 0xfa6a14398957efe4ULL, 0x8c964cc8dd693be6ULL, 0xda39d305b1aa4402ULL, 0x5cefe0d471be1303ULL, 0x022555566f4b0258ULL, 0xa977db187aa459c1ULL, 0xdbc9cda75be3d461ULL, 0x28c9c44127a7ad18ULL, 0x0cb1c4a0928463acULL, 0x6341fbba111f601eULL, 0x3eb1047b53381533ULL, 0x173fa894269650b7ULL, 0x24e2053b86c757a8ULL, 0x19da868d15594e02ULL, 0xe9e1bb0d334d43f9ULL, 0x26d5d0d7d64b3a87ULL, 0xa84b17df37d8bd87ULL },
+    };
+};
+
+template<>
+struct vetted_multipliers<64> {
+    static constexpr std::size_t size = 8;
+    static constexpr double merit[ size ] = { 0.644364, 0.592164, 0.559208, 0.532595, 0.517397, 0.513115, 0.492694, 0.481543 };
+    static constexpr mp_limb_t value[ size ][ 64 ] = {
+        { 0xe4889d494e28d6fdULL, 0x366bf99cecec3ea2ULL, 0xcc521fce07744328ULL, 0x67ecb399e6a69cc6ULL, 0x963013c126caee36ULL, 0x9678d5610e341ee0ULL, 0x61d2e6432952f71eULL, 0x5b881237746d6d21ULL, 0xc1bd5a2b7d1497bcULL, 0x634f6c2013f5e872ULL, 0x0d7c5484dfc0619dULL, 0x26a5602b997f060eULL, 0x67486b3e5ae9776aULL, 0x0eb0d58a79b12d23ULL, 0x9f99030f2f996773ULL, 0x9680a48e36d9552aULL, 0x117adaf2ba81fe32ULL, 0x2913df5d168d9f43ULL, 0xb2e7274e2731a3f0ULL, 0x1d90a6ba2861772dULL, 0x54249ee61ba7cc43ULL, 0xd9039034f75c1e27ULL, 0x79af610800a5200bULL, 0x0064d5663a36f6caULL, 0x711a32d0d54a92baULL, 0x6c999c867d3c0050ULL, 0x8094c03d11b2590eULL, 0xb9cc5a653f4509c8ULL, 0x1f3e8aa98a0818a6ULL, 0xc1d8cafccaec9e23ULL, 0x0111d8b059b33f38ULL, 0x333bc8769016aa55ULL, 0x3e53c446f5958d43ULL, 0x45ed22ab429aebbaULL, 0x53508e85f04d2a33ULL, 0x4e66c7beab941520ULL, 0xdcd73a7d66eca159ULL, 0x9cb230b3b4987abcULL, 0xcc641a5937993d77ULL, 0x13cfcbfd63fb231cULL, 0x9acf6625f977ea58ULL, 0x1cddbec26f9b8f39ULL, 0xe3d15f9656f849f9ULL, 0xee2e64d7921c40d0ULL, 0x4f3d77b7dbeabbfeULL, 0xfd75c80da2367dedULL, 0x7f939996a043c257ULL, 0x2597b3e34d65a112ULL, 0x7a0308fe7cf48665ULL, 0xb91dd2974421dcfbULL, 0xdbf4bbfc46cab8dfULL, 0xf57720b1a3d6728fULL, 0x80a2aecafbc2b749ULL, 0x0d24df4f92781811ULL, 0xa310013370e9a2bbULL, 0xab305d35a48af338ULL, 0x78fe536597688f76ULL, 0x9850229c245b7ae4ULL, 0xd6fd4ac346c908baULL, 0x443e0908ea157328ULL, 0xd2bf0552af278aedULL, 0x110dd6eab5ab6ed5ULL, 0xae5abd191ed9977dULL, 0xd2bb1379b5e41c89ULL },
+        { 0xb35efa46d372fae5ULL, 0x4824340517d67521ULL, 0xa75cf5f2d327129cULL, 0xac150e1441312dffULL, 0xe6b59815032497afULL, 0x105cda25f440ade1ULL, 0x657a977d9aa2b1a7ULL, 0x58a6687498fcd7c4ULL, 0xa2e7524cf89fef60ULL, 0x693f7fb0ffd877dbULL, 0x3caed21a0fdce3e6ULL, 0x88fdf36ac56efc5fULL, 0xee4735323b04ee3cULL, 0x85083d7ffc1e1914ULL, 0x51730e0e65e9f75aULL, 0xbbd98bf25eb9a8d7ULL, 0x4d5f023de4cbc368ULL, 0xb9d688fb94fb293eULL, 0x4bd98eecf1543c56ULL, 0x51c0acc52930901cULL, 0x5b2f1f881cd153e7ULL, 0xebbe46b4119c1b4cULL, 0xd900cae55c9ab941ULL, 0xe7c0159580579b6aULL, 0x2e0c8c42eccfe2d3ULL, 0xbf62c5216a6cdd95ULL, 0x4e1bb78088ed9c72ULL, 0x3cd440e9fc9bade3ULL, 0x12735a387c8f8824ULL, 0xd41458f6cf48ad66ULL, 0xef0019df7e264ddeULL, 0x5e9b3707f74694caULL, 0x926174742b941247ULL, 0xb580d5014056985cULL, 0xcf07823366c59c36ULL, 0x8ea3423a573da603ULL, 0x95ce11194a9bd575ULL, 0x9403cd3b8f749d58ULL, 0x290b245ac8c25c5aULL, 0xbf96087a3e3a800fULL, 0xb2337e7e0b525453ULL, 0x0ae8fa9b6e968ba8ULL, 0x3226c084c70ab68dULL, 0x27465dc9adb4636aULL, 0x909c53c04c336255ULL, 0x0bc2d6b1289875c1ULL, 0x7e257f1f03f01a5dULL, 0xbc8e8b271be3de92ULL, 0x215264c35c7ad5c8ULL, 0x57234e116b8e47d9ULL, 0xf09e8633a2f5aba7ULL, 0xd66e539a8ccbed57ULL, 0xbe12547d7d185906ULL, 0x26aaef432446fe00ULL, 0x6a6ef9a46ec163cdULL, 0x85b1db6f6e54b256ULL, 0x8c9dc339982d0a1bULL, 0x24be3ea6e24db993ULL, 0x377bc83102aea809ULL, 0x03bc36a5420684faULL, 0x98dfff7686636db0ULL, 0x5c10769727855e83ULL, 0x159c540e109b0508ULL, 0xf08a18fd93b9a73aULL },
+        { 0xf45f707addfb94ddULL, 0xf84a3cdb5b38af1cULL, 0xe85effaef3196477ULL, 0x0e3c96f76a890744ULL, 0x7d8f9b2b40f0be0dULL, 0x3ad23a0a69af5102ULL, 0xaa2f911b5db9e503ULL, 0x0be22367f8683865ULL, 0x8ba73081111e464dULL, 0xc4336f2b9a7c4f32ULL, 0x4b242f8453a788c9ULL, 0xb77781f7cc84a376ULL, 0x2a368b1938036554ULL, 0x0970194ff2288543ULL, 0x96bc61e827e51b21ULL, 0x0266d738d26ce7aaULL, 0x999854db4b55fdbcULL, 0x29558e4ce956094bULL, 0x790d6b4d87cd9d80ULL, 0x022d1b0f392b4226ULL, 0xe75ee2680f04c360ULL, 0x6c50e79cd46189b2ULL, 0x299070da5ae6b50bULL, 0x629527e1995ac50fULL, 0xffd430190b1b1554ULL, 0x93974502f0904368ULL, 0x5f5fac7bf8cf5702ULL, 0x47c5a47c3d84f9b0ULL, 0x1407961d4c281bceULL, 0x3a05de5c1a9ba1f3ULL, 0xe1e590f0e93ad34bULL, 0xfd7dda016287922cULL, 0x505ac6091df1a954ULL, 0xb1db0e09ee2976f1ULL, 0x692a7ebbb997b389ULL, 0x2ccfafc5c93b0b8eULL, 0x9b9203b3904ce54eULL, 0xa745f2eb361dc8b2ULL, 0x25fabc7e3bef4b02ULL, 0x221fb6168cc10619ULL, 0xf3be3d54c794074dULL, 0xecd34ee6cbbc57b7ULL, 0x7bb5e5af65dfc338ULL, 0x750a279aa067711dULL, 0xb3cbb567af7503c2ULL, 0x7a08a07a32d1a9dcULL, 0x5c45d57cbdab967bULL, 0x757a5481f606f5e8ULL, 0x6d517457dd62e65dULL, 0x9304bc893f27c090ULL, 0x13e1739f5525d6c3ULL, 0x4edd7fff5482f799ULL, 0xc9990576ec260914ULL, 0xf825ddc96bdb3541ULL, 0x648da5f0cfa2516dULL, 0x1bbb77cbb09201d2ULL, 0x18ccddbac135556bULL, 0x8268a503cb5d909dULL, 0xcd67ab8e31b4dbf1ULL, 0xaf7559d39ca5f318ULL, 0xb00a63bfd0bc1b5eULL, 0x57bdca7ad8313490ULL, 0x49876872067a5550ULL, 0xd143cc65977d5f1cULL },
+        { 0xe13155df009072adULL, 0xd580e4e464bfc3d8ULL, 0xd228b884bd0c4cf2ULL, 0x9204fa9efcdcdaf5ULL, 0x5e8208477e7c5715ULL, 0xa693ef194bdfb0e5ULL, 0x9042c19eae511d10ULL, 0x37c3ba2c263aeb17ULL, 0x9c572e229edf8748ULL, 0xaaa6d270fd002151ULL, 0xb5d2d44a1c3d935dULL, 0xe6adc7e4a90c474eULL, 0xebf9707f67ced0dbULL, 0x412a34cf7c6682d1ULL, 0x3b631339119c70fcULL, 0x32ddb72679bffc79ULL, 0xf8324e8c06b3cc1aULL, 0x41f2ececc5a45158ULL, 0x9bdb0851b309d3b3ULL, 0xa330b6c60136b7b0ULL, 0xd10b743cb6d99420ULL, 0x405eba55454f2699ULL, 0xb36eaef62b45f8edULL, 0xb378b067899e6ab0ULL, 0x2bc2888cc972aeffULL, 0x53b8db647dd52776ULL, 0xefff29dc2d42d655ULL, 0x3b3f65a3ea2ee579ULL, 0x8e57ead5647c1e84ULL, 0x45e38e4b4fa8cdd9ULL, 0x600e5dd53606bff3ULL, 0xf714572bb4b58471ULL, 0x77719763efd69839ULL, 0x214669cc032b7f38ULL, 0x52f20bb8364d8e10ULL, 0x05457f8d5d0b1851ULL, 0xf56a8f010887f8f8ULL, 0x77a56ea24d2e6aaeULL, 0x7d5fbf98f62a3d0cULL, 0xc24ac0eed49b2499ULL, 0x8bccd5799a6715edULL, 0x0d37756044984a19ULL, 0xec4e4d255b57ac97ULL, 0xf0545c577a98601cULL, 0x25a80abd9db5a1f6ULL, 0x63c882716b19b692ULL, 0xf52cb456d37a875bULL, 0x19039885d32c0bdcULL, 0xbc3d5611ae563b1cULL, 0x81f06721117b6105ULL, 0x58fd5769db6bae75ULL, 0xcfa3f0209c2148e1ULL, 0x44796b998c1cbbb6ULL, 0x6479cdedc4f5eb81ULL, 0xed5d65381617379cULL, 0xed3600b70ae8c33fULL, 0x1480816e874b24a9ULL, 0x96e2bb77848db956ULL, 0x628b25db833d871bULL, 0x1d9121be186a3235ULL, 0xb062cc6fed4449bcULL, 0x6299fedc849efb08ULL, 0x71217e8fd2fa4196ULL, 0xba58866b8705b8baULL },
+        { 0x15ace73c9b4ca0ddULL, 0x2a138c8b1e4cc3d2ULL, 0x8ffa3dc6f1b07b6eULL, 0xb747a6cf320cd525ULL, 0xf9715b30d1af173bULL, 0xea6d57b0bf1a72e6ULL, 0x917739fe32ab3f9cULL, 0x59ad700de6250c78ULL, 0x72c801b9ffdbca95ULL, 0x3ba6062ab342659cULL, 0xb0a63c2924dbf857ULL, 0xff74883b4f9b65b0ULL, 0xed9810333b36857dULL, 0xe80c5f0dea38fd02ULL, 0x31c4b9bbd58bf3caULL, 0x8bd0e30581da5116ULL, 0x9f47dc42e2f4484dULL, 0x317cad07e813f614ULL, 0x6b54b81d7818bd22ULL, 0xa4b6df496e22c63fULL, 0x192e39690dfa5341ULL, 0x446ca96769f88ec4ULL, 0x6a049dc64f8a3c25ULL, 0x2fe3c7410dae147dULL, 0x2006c811f2970e86ULL, 0xdc667b7a19abf0d9ULL, 0x92425deb081808d7ULL, 0xe8b94a77903eacc0ULL, 0xaa4c936881d2c976ULL, 0x6b3b16cdafe18186ULL, 0x3c5e19640b8ca1d5ULL, 0x026a290a51c3d42dULL, 0x3c453a3f2f589becULL, 0xfc2803ef346b9a13ULL, 0x1e58caf5cb4ca4bbULL, 0x89710c9692d26f7cULL, 0xe925dc14572c042dULL, 0x537e3796c072fec6ULL, 0x828dfeddc8d1995eULL, 0x6fe6a54bdbe1f7f8ULL, 0x27a472bc1e23de33ULL, 0x1a91b28622d64e8bULL, 0x6d8403101ad4f6caULL, 0x0021457f64da28b1ULL, 0x01046d01ee0460bcULL, 0xa9ec0952c300d651ULL, 0xa8d5aa2f3c1b9c7fULL, 0x08cf78c6efc34de6ULL, 0x4de8d712c89d76d8ULL, 0xc0a8b118930d7797ULL, 0x09268e3f99928669ULL, 0x6dbab5d78102af34ULL, 0x01e4b932a7a93044ULL, 0xf164cb179fd95194ULL, 0x5e82c3cca761a074ULL, 0xd517c07ddf3b8aaaULL, 0x59a78eb316d0e0a2ULL, 0xd1b4df13acf5dc90ULL, 0x499c024d8ade3854ULL, 0x249e418b26a20409ULL, 0xc183617703697025ULL, 0xeffec2becfc8efd2ULL, 0xe5998abdbd6d995cULL, 0x104a9aa40895db4aULL },
+        { 0xb16e1fcea17c761dULL, 0x4e3c36f0b26761beULL, 0x5d20d025f07c5c56ULL, 0x614e7cedfad12a92ULL, 0xc5b9324a57b66ea6ULL, 0x6e21df1623b02ab9ULL, 0x569a038f1a164c88ULL, 0x06e727c467aaa357ULL, 0xe984e60992a58d78ULL, 0xac0db2a7888fa822ULL, 0x45ac0976d6ef0101ULL, 0x8c1920efb5a5fe72ULL, 0xb56915a51a17dba0ULL, 0x444a92242f7f44bdULL, 0x9a30403f99b80ef6ULL, 0x18780eca6e5efc12ULL, 0xdad0ae7a4d78101bULL, 0x403ba4f96605b4e9ULL, 0xb166b593b2e52770ULL, 0x9b10e0dcc96a8902ULL, 0x130dc847d80fe8d5ULL, 0xbae16c5f7173c980ULL, 0xdd45058150215429ULL, 0x80deeccd41f8c39cULL, 0x28dbd635d2d50c8fULL, 0xcfd839f37aafe069ULL, 0x54d65afd7370be23ULL, 0x59470fe70d5d26b6ULL, 0x41d30b0a12df8f50ULL, 0xbc7d866c9953166eULL, 0xad435d1e92fe75baULL, 0xc0a2483b22ca2feeULL, 0x16ed91054202fe6dULL, 0x6d46af1dd9340addULL, 0xb49e7a961c632331ULL, 0x3f9b4e13b855feadULL, 0x312b9a90068d2f7eULL, 0x63a664f911ab6229ULL, 0x79c96ea557cc66ecULL, 0xd68cb954e6b4ac1bULL, 0x5ef8d6e00c88717fULL, 0x5a1c1db3de62fff8ULL, 0xd55149a73183a6faULL, 0xd0874f3e49597212ULL, 0xd2686e0bc747ef8cULL, 0xbbc84198d73d0aabULL, 0xfb0f3f6be86840cfULL, 0x74dc6e9ce573eecfULL, 0xfe6ac449bb6eed91ULL, 0x779e856c6ad84346ULL, 0x695e5fc54cbd153eULL, 0x4060f132535df3c5ULL, 0xf7209541b76152c1ULL, 0x3d17957d97636f63ULL, 0xcb71fd4dc845db2bULL, 0x0dc6dc6db8b2965bULL, 0xc1d53a5887e69a71ULL, 0x03315156e4656d38ULL, 0x42939977a855ae3bULL, 0x4bae04d5908fcd4fULL, 0xb1f29c0d17de4c1bULL, 0x82e5facfa771a2c2ULL, 0xa2925070ea01dd03ULL, 0xf2d857f9ebcaf1e4ULL },
+        { 0xfe6bd879e43bf60dULL, 0x4ac2dc040224c064ULL, 0x6b411519814ca964ULL, 0x3b2149a8110d7e9eULL, 0x67fe6182a8290bffULL, 0xf9bd7a0a3bc4d34cULL, 0xb6c4b4ed67565ba0ULL, 0x441545bb193ca2b6ULL, 0xfb72d082ce2b4a5bULL, 0x84336e9bd58b950aULL, 0x4e0e8d629bc10aedULL, 0x8b2ff436f7e99cfaULL, 0xde63821705481a66ULL, 0x9668e29b05cffb49ULL, 0x5f1dcf89da5cc17aULL, 0x51b72e6574d7f8cfULL, 0x275114e50814500fULL, 0xa1d41a9231b86564ULL, 0x522cfb9a97bfbef6ULL, 0xc743f22e2bd65a57ULL, 0x8dbf190a84439540ULL, 0xc9c7c85f0c1cfe3fULL, 0x7d3aa7cc9601ece3ULL, 0xfbaf810e498b44e9ULL, 0x054ba39f8f6555a4ULL, 0xe34c9bc3865a44f4ULL, 0x3c8d3fec3a195937ULL, 0x935412544422a875ULL, 0x7e76db81f3d83abfULL, 0xc5cd1afe61210279ULL, 0xfd9957826242c6cfULL, 0xeee8f55903ae2627ULL, 0xeb5871a12ccbf4eaULL, 0x7802f3bb9d0514c7ULL, 0x61ace11c71fc01fbULL, 0xa8c59739713c71ccULL, 0xce77bf2f9d59b756ULL, 0x097456f66d33a05fULL, 0xee33bdeda95f5bd0ULL, 0xe02eee2b881ca458ULL, 0x9348ad70a84360f6ULL, 0x1af7a9ee234bc1acULL, 0x17a31a8be67b8f91ULL, 0xb5bd62e2598f9e3eULL, 0xbf260cc3299bb348ULL, 0xc896e117b07da04aULL, 0xde2f7be295e7473aULL, 0x5412c7cefc463e80ULL, 0x81ff89e26c93576cULL, 0x748b5fcfefbfe74aULL, 0x7f48bf5b5671d563ULL, 0x5d724830301ee64bULL, 0x1ea4860cde9b0718ULL, 0x2a6fa175d2cf69e5ULL, 0x33f150272467fe18ULL, 0x6acfef11fbb03004ULL, 0xe667015ce277f426ULL, 0xc4e93355220bf7b3ULL, 0x507a237c382c8a58ULL, 0x666c0de9cefc5351ULL, 0x7a7378ac894ab9b0ULL, 0x7d5d7c131c972105ULL, 0xa9efa53a8bea3c63ULL, 0xa07db06dc0179a05ULL },
+        { 0x0e9b13d7be5404e5ULL, 0x52818f8f110c0bddULL, 0x650f062fa186aba3ULL, 0x33024df38a3e2c7cULL, 0xaa99c67cc000764bULL, 0x8522ca7cf0087a67ULL, 0xa93c37a89f15a44fULL, 0x431c22247178f65cULL, 0xc3a26a07db7e7fbeULL, 0xb7d4f21ad72d38f5ULL, 0x26095f60cb7cbfdfULL, 0x1b0d2361384efae4ULL, 0x66742ade1a39fc27ULL, 0xe6826ddde48e1a05ULL, 0xac360c21da3d7f67ULL, 0xdb707fb1930b8344ULL, 0xedccd509e60ed4beULL, 0x0b82e7b5a9f3bb05ULL, 0xca3e9f80275580d2ULL, 0x37cbc57cca94a8c9ULL, 0x5e04e078dc7d87e2ULL, 0x465678cdc3994841ULL, 0x620314e5cbcf2cedULL, 0xe098f0c817ef619aULL, 0x16bab82c2993f9adULL, 0x593508e7d67d41e3ULL, 0x5824d395af4c93ddULL, 0x1c228640c330d927ULL, 0x33b1b68e96d1a5c8ULL, 0x19db83c2dc19a976ULL, 0x81539c587345431cULL, 0x6629613768f51987ULL, 0x285ede4cb248c17cULL, 0x23fedc817a0ccc1dULL, 0xe5908c6bb9d095a4ULL, 0x61c731f9a829422cULL, 0x240cfe887359ee50ULL, 0xe689f2303f6f006cULL, 0x02be57339be8def4ULL, 0x988128be702f07c7ULL, 0xc9d8d74a281dc015ULL, 0xcb0f32f99a9cc094ULL, 0x77b1274f0bc02df7ULL, 0xfb47acd7f866caffULL, 0xaa7c5e6be1d3bbb6ULL, 0x515e6a7ccd728f58ULL, 0x3adbb11826c68bffULL, 0xb5b44060873e5282ULL, 0xba5f96eb71fa6f7eULL, 0x110d61de56915ec1ULL, 0x83f7d439c11782d8ULL, 0x4938e2cf8757d353ULL, 0xa3066fa098d23e93ULL, 0xf66e8fa039ccae5cULL, 0xdc82dc3ba0f2b9c3ULL, 0xdcc4d100341df458ULL, 0x47fa7bcb81ad307fULL, 0xf56de62d08daa397ULL, 0xe90c02d5a29cb31aULL, 0x35ba7f45ffc5624bULL, 0x73d76a3b650fbe8aULL, 0x9b33bc8da6c6072aULL, 0x634f5ad528d8db5fULL, 0x0bde6381210ca5d9ULL },
+    };
+};
@@ -0,0 +1,354 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <execution>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// Number theoretic transform products, for multiplying many numbers by one
+// fixed multiplier: the multiplier's transforms are computed once, each
+// product then costs one forward and one inverse transform (per prime) and a
+// pointwise product, where mpn_mul's FFT does two forward transforms.
+//
+// The limbs are the digits, and a coefficient of the convolution of numbers of
+// n limbs is below n 2^128, so three primes below 2^62 (c 2^32 + 1, product
+// above 2^185) hold them exactly, up to n = 2^32. The transforms multiply by
+// constants ( Shoup ), the residues are combined with Garner's algorithm, in
+// Montgomery form.
+
+namespace ntt_detail {
+
+using u128 = unsigned __int128;
+
+struct modulus_t {
+    std::uint64_t p, p_inv, r2; // -p^-1 mod 2^64, 2^128 mod p.
+    std::uint64_t root;         // A primitive root.
+
+    constexpr modulus_t ( const std::uint64_t p_, const std::uint64_t root_ ) noexcept :
+        p ( p_ ), p_inv ( 0 ), r2 ( 0 ), root ( root_ ) {
+        std::uint64_t inv = p;
+        for ( int i = 0; i < 5; ++i )
+            inv *= 2 - p * inv;
+        p_inv                 = 0 - inv;
+        const std::uint64_t r = std::uint64_t ( ( u128{ 1 } << 64 ) % p );
+        r2                    = std::uint64_t ( u128{ r } * r % p );
+    }
+
+    // t_ R^-1 mod p, for t_ < p 2^64.
+    [[nodiscard]] constexpr std::uint64_t reduce ( const u128 t_ ) const noexcept {
+        const std::uint64_t m = std::uint64_t ( t_ ) * p_inv;
+        const std::uint64_t u = std::uint64_t ( ( t_ + u128{ m } * p ) >> 64 );
+        return u >= p ? u - p : u;
+    }
+    [[nodiscard]] constexpr std::uint64_t mul ( const std::uint64_t a_, const std::uint64_t b_ ) const noexcept {
+        return reduce ( u128{ a_ } * b_ );
+    }
+    // Any 64-bit x_ to Montgomery form.
+    [[nodiscard]] constexpr std::uint64_t to ( const std::uint64_t x_ ) const noexcept { return mul ( x_, r2 ); }
+    [[nodiscard]] constexpr std::uint64_t add ( const std::uint64_t a_, const std::uint64_t b_ ) const noexcept {
+        const std::uint64_t s = a_ + b_;
+        return s >= p ? s - p : s;
+    }
+    [[nodiscard]] constexpr std::uint64_t sub ( const std::uint64_t a_, const std::uint64_t b_ ) const noexcept {
+        return a_ >= b_ ? a_ - b_ : a_ + p - b_;
+    }
+    // x_^e_, in and out in Montgomery form.
+    [[nodiscard]] constexpr std::uint64_t pow ( std::uint64_t x_, std::uint64_t e_ ) const noexcept {
+        std::uint64_t r = to ( 1 );
+        for ( ; e_; e_ >>= 1, x_ = mul ( x_, x_ ) )
+            if ( e_ & 1 )
+                r = mul ( r, x_ );
+        return r;
+    }
+};
+
+inline constexpr std::array<modulus_t, 3> moduli{ modulus_t{ 0x3fff'ffee'0000'0001ULL, 3 }, modulus_t{ 0x3fff'ffb4'0000'0001ULL, 19 },
+                                                  modulus_t{ 0x3fff'ffa0'0000'0001ULL, 3 } };
+
+// Shoup's product by a constant w: with w' = floor ( w 2^64 / p ), x w mod p
+// is x w - floor ( x w' / 2^64 ) p, in [ 0, 2p ), for any 64-bit x.
+struct constant_t {
+    std::uint64_t w, w_shoup;
+
+    constant_t ( ) noexcept = default;
+    constant_t ( const std::uint64_t w_, const std::uint64_t p_ ) noexcept :
+        w ( w_ ), w_shoup ( std::uint64_t ( ( u128{ w_ } << 64 ) / p_ ) ) {}
+
+    [[nodiscard]] std::uint64_t mul ( const std::uint64_t x_, const std::uint64_t p_ ) const noexcept {
+        return x_ * w - std::uint64_t ( ( u128{ x_ } * w_shoup ) >> 64 ) * p_;
+    }
+};
+
+// f_ ( i ) for i in [ 0, n_ ), on the cores ( std::execution::par ) if
+// parallel_.
+template<typename Function>
+void for_each_index ( const bool parallel_, const std::size_t n_, Function f_ ) {
+    if ( not parallel_ ) {
+        for ( std::size_t i = 0; i < n_; ++i )
+            f_ ( i );
+        return;
+    }
+    std::vector<std::size_t> indices ( n_ );
+    std::iota ( indices.begin ( ), indices.end ( ), std::size_t{ 0 } );
+    std::for_each ( std::execution::par, indices.begin ( ), indices.end ( ), f_ );
+}
+
+// Transforms of length n ( a power of 2 ) modulo one prime, Harvey's lazy
+// butterflies ( p < 2^62, the values stay below 4p ). forward is decimation in
+// frequency, natural order in ( below 2p ), bit-reversed out, inverse is
+// decimation in time, bit-reversed in, out in natural order but with the
+// indices negated mod n ( it uses the forward roots, a transform by w^-1 being
+// one by w, reversed ), below 4p. Both recurse depth first, so that all but
+// the first few stages run in cache; in parallel, the halves of a recursion
+// run concurrently, and the stages above them in pieces. The roots of the
+// stage of half size h, w^( j n / 2h ) for j < h, are roots[ h + j ].
+struct transform_t {
+    std::uint64_t p = 0;
+    std::size_t n   = 0;
+    std::vector<constant_t> roots;
+
+    static constexpr std::size_t block = 1'024;              // In cache, iterative.
+    static constexpr std::size_t grain = std::size_t{ 1 } << 15; // Of the parallel work.
+
+    transform_t ( ) noexcept = default;
+    transform_t ( const modulus_t & m_, const std::size_t n_ ) : p ( m_.p ), n ( n_ ), roots ( std::max ( n_, std::size_t{ 2 } ) ) {
+        for ( std::size_t h = n / 2; h; h /= 2 ) {
+            const std::uint64_t w = m_.pow ( m_.to ( m_.root ), ( m_.p - 1 ) / ( 2 * h ) );
+            std::uint64_t x       = m_.to ( 1 );
+            for ( std::size_t j = 0; j < h; ++j, x = m_.mul ( x, w ) )
+                roots[ h + j ] = constant_t ( m_.reduce ( x ), p );
+        }
+    }
+
+    void forward ( std::uint64_t * a_, const bool parallel_ = false ) const { forward ( a_, n, parallel_ ); }
+    void inverse ( std::uint64_t * a_, const bool parallel_ = false ) const { inverse ( a_, n, parallel_ ); }
+
+    private:
+    // The butterflies [ first_, last_ ) of the h_ half size stage of a block.
+    void forward_butterflies ( std::uint64_t * x_, const std::size_t h_, const std::size_t first_,
+                               const std::size_t last_ ) const noexcept {
+        const constant_t * r = roots.data ( ) + h_;
+        std::uint64_t * y    = x_ + h_;
+        for ( std::size_t j = first_; j < last_; ++j ) {
+            const std::uint64_t u = x_[ j ], v = y[ j ], s = u + v;
+            x_[ j ]               = s >= 2 * p ? s - 2 * p : s;
+            y[ j ]                = r[ j ].mul ( u - v + 2 * p, p );
+        }
+    }
+    void inverse_butterflies ( std::uint64_t * x_, const std::size_t h_, const std::size_t first_,
+                               const std::size_t last_ ) const noexcept {
+        const constant_t * r = roots.data ( ) + h_;
+        std::uint64_t * y    = x_ + h_;
+        for ( std::size_t j = first_; j < last_; ++j ) {
+            const std::uint64_t u = x_[ j ] >= 2 * p ? x_[ j ] - 2 * p : x_[ j ], v = r[ j ].mul ( y[ j ], p );
+            x_[ j ]               = u + v;
+            y[ j ]                = u - v + 2 * p;
+        }
+    }
+
+    void forward ( std::uint64_t * a_, const std::size_t size_, const bool parallel_ ) const {
+        const std::size_t h = size_ / 2;
+        if ( size_ <= block ) {
+            for ( std::size_t stage = h; stage; stage /= 2 )
+                for ( std::size_t i = 0; i < size_; i += 2 * stage )
+                    forward_butterflies ( a_ + i, stage, 0, stage );
+            return;
+        }
+        const bool parallel = parallel_ and size_ > grain;
+        for_each_index ( parallel, parallel ? h / grain : 1, [ & ] ( const std::size_t i ) {
+            forward_butterflies ( a_, h, parallel ? i * grain : 0, parallel ? ( i + 1 ) * grain : h );
+        } );
+        for_each_index ( parallel, 2, [ & ] ( const std::size_t i ) { forward ( a_ + i * h, h, parallel ); } );
+    }
+    void inverse ( std::uint64_t * a_, const std::size_t size_, const bool parallel_ ) const {
+        const std::size_t h = size_ / 2;
+        if ( size_ <= block ) {
+            for ( std::size_t stage = 1; stage < size_; stage *= 2 )
+                for ( std::size_t i = 0; i < size_; i += 2 * stage )
+                    inverse_butterflies ( a_ + i, stage, 0, stage );
+            return;
+        }
+        const bool parallel = parallel_ and size_ > grain;
+        for_each_index ( parallel, 2, [ & ] ( const std::size_t i ) { inverse ( a_ + i * h, h, parallel ); } );
+        for_each_index ( parallel, parallel ? h / grain : 1, [ & ] ( const std::size_t i ) {
+            inverse_butterflies ( a_, h, parallel ? i * grain : 0, parallel ? ( i + 1 ) * grain : h );
+        } );
+    }
+};
+
+// The transforms of length n_ for the three primes, built once per length and
+// shared.
+[[nodiscard]] inline const std::array<transform_t, 3> & transforms ( const std::size_t n_ ) {
+    static std::mutex mutex;
+    static std::map<std::size_t, std::unique_ptr<const std::array<transform_t, 3>>> cache;
+    std::lock_guard<std::mutex> lock ( mutex );
+    auto & t = cache[ n_ ];
+    if ( not t )
+        t = std::make_unique<const std::array<transform_t, 3>> (
+            std::array<transform_t, 3>{ transform_t ( moduli[ 0 ], n_ ), transform_t ( moduli[ 1 ], n_ ), transform_t ( moduli[ 2 ], n_ ) } );
+    return *t;
+}
+
+} // namespace ntt_detail
+
+// Products a b, a of a_limbs limbs, b fixed, of b_limbs limbs. Transforms of
+// parallel_threshold points and up run on all cores ( on a multi-core host ):
+// the primes, the halves of the transforms and pieces of the carry
+// propagation concurrently.
+class ntt_multiplier {
+
+    using modulus_t  = ntt_detail::modulus_t;
+    using constant_t = ntt_detail::constant_t;
+    using u128       = ntt_detail::u128;
+
+    std::size_t _a_limbs = 0, _b_limbs = 0, _n = 0;
+    bool _parallel                                       = false;
+    const std::array<ntt_detail::transform_t, 3> * _transforms = nullptr;
+    std::array<std::vector<constant_t>, 3> _b; // The transforms of b, over n.
+    std::array<std::vector<std::uint64_t>, 3> _work;
+
+    // Garner's constants, in Montgomery form.
+    std::uint64_t _p0_inv_1 = 0, _p0_2 = 0, _p0p1_inv_2 = 0;
+    u128 _p0p1 = 0;
+
+    public:
+    static constexpr std::size_t parallel_threshold = std::size_t{ 1 } << 16;
+
+    ntt_multiplier ( ) noexcept = default;
+    ntt_multiplier ( const std::uint64_t * b_, const std::size_t b_limbs_, const std::size_t a_limbs_ ) :
+        _a_limbs ( a_limbs_ ), _b_limbs ( b_limbs_ ) {
+        const auto & m = ntt_detail::moduli;
+        for ( _n = 2; _n < _a_limbs + _b_limbs - 1; _n *= 2 )
+            ;
+        _parallel   = _n >= parallel_threshold and std::thread::hardware_concurrency ( ) > 1;
+        _transforms = &ntt_detail::transforms ( _n );
+        ntt_detail::for_each_index ( _parallel, 3, [ & ] ( const std::size_t k ) {
+            _work[ k ].resize ( _n );
+            std::uint64_t * w = _work[ k ].data ( );
+            load ( w, b_, _b_limbs, m[ k ].p );
+            ( *_transforms )[ k ].forward ( w, _parallel );
+            const std::uint64_t n_inv = m[ k ].pow ( m[ k ].to ( _n ), m[ k ].p - 2 );
+            _b[ k ].resize ( _n );
+            for ( std::size_t i = 0; i < _n; ++i )
+                _b[ k ][ i ] = constant_t ( m[ k ].mul ( w[ i ], n_inv ), m[ k ].p ); // b^ / n, normal form.
+        } );
+        _p0_inv_1   = m[ 1 ].pow ( m[ 1 ].to ( m[ 0 ].p ), m[ 1 ].p - 2 );
+        _p0_2       = m[ 2 ].to ( m[ 0 ].p );
+        _p0p1       = u128{ m[ 0 ].p } * m[ 1 ].p;
+        _p0p1_inv_2 = m[ 2 ].pow ( m[ 2 ].to ( std::uint64_t ( _p0p1 % m[ 2 ].p ) ), m[ 2 ].p - 2 );
+    }
+
+    [[nodiscard]] std::size_t transform_size ( ) const noexcept { return _n; }
+    [[nodiscard]] bool parallel ( ) const noexcept { return _parallel; }
+
+    // r_ [ 0, a_limbs + b_limbs ) = a_ b.
+    void multiply ( const std::uint64_t * a_, std::uint64_t * r_ ) {
+        const auto & m = ntt_detail::moduli;
+        ntt_detail::for_each_index ( _parallel, 3, [ & ] ( const std::size_t k ) {
+            std::uint64_t * w = _work[ k ].data ( );
+            load ( w, a_, _a_limbs, m[ k ].p );
+            ( *_transforms )[ k ].forward ( w, _parallel );
+            const constant_t * b = _b[ k ].data ( );
+            for ( std::size_t i = 0; i < _n; ++i )
+                w[ i ] = b[ i ].mul ( w[ i ], m[ k ].p );
+            ( *_transforms )[ k ].inverse ( w, _parallel );
+        } );
+        // Pieces of the coefficients, each with its own running carry, added
+        // in at the end of the piece afterwards.
+        const std::size_t size = _a_limbs + _b_limbs, coefficients = size - 1;
+        const std::size_t piece  = _parallel ? ntt_detail::transform_t::grain : coefficients;
+        const std::size_t pieces = ( coefficients + piece - 1 ) / piece;
+        std::vector<u128> carries ( pieces );
+        r_[ coefficients ] = 0;
+        ntt_detail::for_each_index ( _parallel, pieces, [ & ] ( const std::size_t i ) {
+            carries[ i ] = combine ( r_, i * piece, std::min ( coefficients, ( i + 1 ) * piece ) );
+        } );
+        for ( std::size_t i = 0; i < pieces; ++i ) {
+            u128 carry = carries[ i ];
+            for ( std::size_t l = std::min ( coefficients, ( i + 1 ) * piece ); carry and l < size; ++l ) {
+                const u128 s = u128{ r_[ l ] } + std::uint64_t ( carry );
+                r_[ l ]      = std::uint64_t ( s );
+                carry        = ( carry >> 64 ) + ( s >> 64 );
+            }
+        }
+    }
+
+    private:
+    // Limbs below 2p, zero padded to n.
+    void load ( std::uint64_t * w_, const std::uint64_t * x_, const std::size_t limbs_, const std::uint64_t p_ ) const noexcept {
+        for ( std::size_t i = 0; i < limbs_; ++i ) {
+            std::uint64_t x = x_[ i ];
+            x               = x >= 2 * p_ ? x - 2 * p_ : x;
+            w_[ i ]         = x >= 2 * p_ ? x - 2 * p_ : x;
+        }
+        std::fill ( w_ + limbs_, w_ + _n, std::uint64_t{ 0 } );
+    }
+
+    // Garner: x = x0 + p0 t1 + p0 p1 t2, then the coefficients [ first_,
+    // last_ ), of up to 3 limbs each, are added up into r_ with a running
+    // carry, which is returned. Coefficient i is at index -i mod n ( the
+    // inverse transform ).
+    [[nodiscard]] u128 combine ( std::uint64_t * r_, const std::size_t first_, const std::size_t last_ ) const noexcept {
+        const auto & m     = ntt_detail::moduli;
+        const auto residue = [ this ] ( const int k_, const std::size_t i_, const std::uint64_t p_ ) noexcept {
+            std::uint64_t x = _work[ k_ ][ ( _n - i_ ) & ( _n - 1 ) ];
+            x               = x >= 2 * p_ ? x - 2 * p_ : x;
+            return x >= p_ ? x - p_ : x;
+        };
+        u128 carry = 0;
+        for ( std::size_t i = first_; i < last_; ++i ) {
+            const std::uint64_t x0 = residue ( 0, i, m[ 0 ].p ), x1 = residue ( 1, i, m[ 1 ].p ), x2 = residue ( 2, i, m[ 2 ].p );
+            const std::uint64_t t1 = m[ 1 ].mul ( m[ 1 ].sub ( x1, x0 >= m[ 1 ].p ? x0 - m[ 1 ].p : x0 ), _p0_inv_1 );
+            const std::uint64_t d2 = m[ 2 ].sub ( x2, x0 >= m[ 2 ].p ? x0 - m[ 2 ].p : x0 );
+            const std::uint64_t t2 =
+                m[ 2 ].mul ( m[ 2 ].sub ( d2, m[ 2 ].mul ( t1 >= m[ 2 ].p ? t1 - m[ 2 ].p : t1, _p0_2 ) ), _p0p1_inv_2 );
+            // x0 + p0 t1 < 2^125, p0 p1 t2 < 2^186.
+            const u128 low  = u128{ m[ 0 ].p } * t1 + x0;
+            const u128 mid  = u128{ std::uint64_t ( _p0p1 ) } * t2;
+            const u128 high = u128{ std::uint64_t ( _p0p1 >> 64 ) } * t2;
+            const u128 sum0 = u128{ std::uint64_t ( low ) } + std::uint64_t ( mid ) + std::uint64_t ( carry );
+            r_[ i ]         = std::uint64_t ( sum0 );
+            carry           = ( carry >> 64 ) + ( low >> 64 ) + ( mid >> 64 ) + high + ( sum0 >> 64 );
+        }
+        return carry;
+    }
+};
+
+// r_ [ 0, a_limbs_ + b_limbs_ ) = a_ b_, in one go ( b_'s transforms
+// included ).
+inline void ntt_mul ( std::uint64_t * r_, const std::uint64_t * a_, const std::size_t a_limbs_, const std::uint64_t * b_,
+                      const std::size_t b_limbs_ ) {
+    ntt_multiplier ( b_, b_limbs_, a_limbs_ ).multiply ( a_, r_ );
+}
@@ -0,0 +1,96 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <execution>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Deterministic parallel generation.
+//
+// rng::generate ( policy, first, last, engine, dist ) splits [ first, last )
+// into chunks of chunk_size values; chunk k is generated by its own engine,
+// seeded with output k + 1 of a splitmix64 stream keyed on one draw from
+// engine, and with its own copy of dist (so cached normals do not leak from
+// one chunk into the next). The chunking does not depend on the policy, so
+// every policy, including the sequential overload, writes identical values.
+// The engine advances by one draw (two for engines of less than 64 bits).
+//
+// The engine has to be constructible from a 64-bit seed.
+
+namespace rng {
+
+inline constexpr std::size_t chunk_size = 4'096;
+
+[[nodiscard]] constexpr std::uint64_t splitmix64 ( std::uint64_t x_ ) noexcept {
+    x_ = ( x_ ^ ( x_ >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    x_ = ( x_ ^ ( x_ >> 27 ) ) * 0x94d049bb133111ebULL;
+    return x_ ^ ( x_ >> 31 );
+}
+
+template<typename Engine>
+[[nodiscard]] std::uint64_t draw_key ( Engine & engine_ ) {
+    if constexpr ( sizeof ( typename Engine::result_type ) < sizeof ( std::uint64_t ) ) {
+        const std::uint64_t hi = std::uint64_t ( engine_ ( ) ) << 32;
+        return hi ^ std::uint64_t ( engine_ ( ) );
+    }
+    else {
+        return std::uint64_t ( engine_ ( ) );
+    }
+}
+
+// The seed of substream k_ of key_.
+[[nodiscard]] constexpr std::uint64_t substream_seed ( const std::uint64_t key_, const std::uint64_t k_ ) noexcept {
+    return splitmix64 ( key_ + ( k_ + 1 ) * 0x9e3779b97f4a7c15ULL );
+}
+
+template<typename ExecutionPolicy, typename RandomIt, typename Engine, typename Dist,
+         typename = std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+void generate ( ExecutionPolicy && policy_, const RandomIt first_, const RandomIt last_, Engine & engine_, const Dist & dist_ ) {
+    static_assert ( std::is_constructible_v<Engine, std::uint64_t>, "the engine has to be constructible from a 64-bit seed" );
+    const std::uint64_t key = draw_key ( engine_ );
+    const std::size_t n     = std::size_t ( std::distance ( first_, last_ ) );
+    std::vector<std::size_t> chunks ( ( n + chunk_size - 1 ) / chunk_size );
+    std::iota ( chunks.begin ( ), chunks.end ( ), std::size_t{ 0 } );
+    std::for_each ( std::forward<ExecutionPolicy> ( policy_ ), chunks.begin ( ), chunks.end ( ), [ & ]( const std::size_t k ) {
+        Engine engine ( substream_seed ( key, k ) );
+        Dist dist            = dist_;
+        const RandomIt first = first_ + k * chunk_size, last = first_ + std::min ( n, ( k + 1 ) * chunk_size );
+        std::generate ( first, last, [ & ] { return dist ( engine ); } );
+    } );
+}
+
+template<typename RandomIt, typename Engine, typename Dist>
+void generate ( const RandomIt first_, const RandomIt last_, Engine & engine_, const Dist & dist_ ) {
+    generate ( std::execution::seq, first_, last_, engine_, dist_ );
+}
+
+} // namespace rng
@@ -0,0 +1,173 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "block.hpp"
+
+// random_view<Engine> is an infinite input range of the values of an engine,
+// random_view<Engine, Dist> one of the values of a distribution applied to
+// them. Values are pulled from the engine BlockSize at a time, through its
+// block interface, and handed out of the buffer.
+//
+//     for ( auto x : random_view ( rng ) | std::views::transform ( f ) | std::views::take ( n ) ) ...
+//
+// The view refers to the engine, which has to outlive it. It is move-only, as
+// a copy would hand out the buffered values twice, so a named view is piped
+// with std::move. fill ( ) copies whole
+// buffers and blocks into contiguous storage, bypassing the per-value path.
+
+namespace random_view_detail {
+
+struct identity_distribution {};
+
+template<typename Dist, typename T>
+struct result_of {
+    using type = typename Dist::result_type;
+};
+template<typename T>
+struct result_of<identity_distribution, T> {
+    using type = T;
+};
+
+} // namespace random_view_detail
+
+template<typename Engine, typename Dist = random_view_detail::identity_distribution, std::size_t BlockSize = 256>
+class random_view : public std::ranges::view_interface<random_view<Engine, Dist, BlockSize>> {
+
+    static constexpr bool raw = std::is_same_v<Dist, random_view_detail::identity_distribution>;
+
+    using engine_result_type = typename Engine::result_type;
+
+    // The buffer seen as an engine, for the distribution to draw from.
+    struct buffered_engine {
+        using result_type = engine_result_type;
+        [[nodiscard]] static constexpr result_type min ( ) noexcept { return Engine::min ( ); }
+        [[nodiscard]] static constexpr result_type max ( ) noexcept { return Engine::max ( ); }
+
+        random_view * view;
+
+        [[nodiscard]] result_type operator( ) ( ) { return view->next ( ); }
+    };
+
+    struct state_t {
+        std::array<engine_result_type, BlockSize> buffer;
+        std::size_t index = BlockSize;
+    };
+
+    public:
+    using value_type = typename random_view_detail::result_of<Dist, engine_result_type>::type;
+
+    class iterator {
+        friend class random_view;
+
+        random_view * _view = nullptr;
+
+        explicit iterator ( random_view * view_ ) noexcept : _view ( view_ ) {}
+
+        public:
+        using value_type      = typename random_view::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator ( ) noexcept = default;
+
+        [[nodiscard]] value_type operator* ( ) const noexcept { return _view->_current; }
+        iterator & operator++ ( ) {
+            _view->pull ( );
+            return *this;
+        }
+        void operator++ ( int ) { ++*this; }
+    };
+
+    random_view ( ) = default;
+    explicit random_view ( Engine & engine_, Dist dist_ = Dist ( ) ) :
+        _engine ( &engine_ ), _dist ( std::move ( dist_ ) ), _state ( std::make_unique<state_t> ( ) ) {}
+
+    random_view ( random_view && ) noexcept = default;
+    random_view & operator= ( random_view && ) noexcept = default;
+
+    [[nodiscard]] iterator begin ( ) {
+        pull ( );
+        return iterator ( this );
+    }
+    [[nodiscard]] static constexpr std::unreachable_sentinel_t end ( ) noexcept { return { }; }
+
+    // Fills out_ with the next out_.size ( ) values; for the raw view whole
+    // blocks go straight from the engine's block interface into out_.
+    void fill ( const std::span<value_type> out_ ) {
+        if constexpr ( raw ) {
+            auto & s             = *_state;
+            const std::size_t n  = std::min ( out_.size ( ), BlockSize - s.index );
+            std::copy_n ( s.buffer.data ( ) + s.index, n, out_.data ( ) );
+            s.index += n;
+            fill_block ( *_engine, out_.subspan ( n ) );
+        }
+        else {
+            auto e = buffered ( );
+            for ( auto & v : out_ )
+                v = _dist ( e );
+        }
+    }
+
+    private:
+    Engine * _engine = nullptr;
+    [[no_unique_address]] Dist _dist;
+    std::unique_ptr<state_t> _state;
+    value_type _current{ };
+
+    [[nodiscard]] engine_result_type next ( ) {
+        auto & s = *_state;
+        if ( s.index == BlockSize ) {
+            fill_block ( *_engine, s.buffer.data ( ), s.buffer.data ( ) + BlockSize );
+            s.index = 0;
+        }
+        return s.buffer[ s.index++ ];
+    }
+
+    [[nodiscard]] buffered_engine buffered ( ) noexcept { return { this }; }
+
+    void pull ( ) {
+        if constexpr ( raw ) {
+            _current = next ( );
+        }
+        else {
+            auto e   = buffered ( );
+            _current = _dist ( e );
+        }
+    }
+};
+
+template<typename Engine>
+random_view ( Engine & ) -> random_view<Engine>;
+template<typename Engine, typename Dist>
+random_view ( Engine &, Dist ) -> random_view<Engine, Dist>;
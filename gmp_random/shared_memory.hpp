@@ -0,0 +1,104 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined( _WIN32 )
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+// A named shared-memory mapping: a POSIX shared-memory object, or a Windows
+// pagefile-backed file mapping. The creator sizes it, others open it as is;
+// creating fails if the name exists already.
+class shared_mapping_t {
+
+    public:
+    enum class mode { create, read_write, read_only };
+
+    shared_mapping_t ( const char * name_, const std::size_t size_, const mode mode_ ) noexcept : _size ( size_ ) {
+        const bool create = mode_ == mode::create, writable = mode_ != mode::read_only;
+#if defined( _WIN32 )
+        _handle = create ? CreateFileMappingA ( INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, DWORD ( std::uint64_t ( size_ ) >> 32 ),
+                                                DWORD ( size_ ), name_ )
+                         : OpenFileMappingA ( writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, FALSE, name_ );
+        if ( _handle and create and GetLastError ( ) == ERROR_ALREADY_EXISTS ) {
+            CloseHandle ( _handle );
+            _handle = nullptr;
+        }
+        if ( _handle )
+            _data = MapViewOfFile ( _handle, writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, size_ );
+#else
+        const int fd = shm_open ( name_, create ? O_CREAT | O_EXCL | O_RDWR : writable ? O_RDWR : O_RDONLY, 0644 );
+        if ( fd < 0 )
+            return;
+        if ( not create or not ftruncate ( fd, off_t ( size_ ) ) ) {
+            void * p = mmap ( nullptr, size_, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0 );
+            _data    = p == MAP_FAILED ? nullptr : p;
+        }
+        close ( fd );
+#endif
+    }
+
+    shared_mapping_t ( shared_mapping_t && )      = delete;
+    shared_mapping_t ( const shared_mapping_t & ) = delete;
+
+    shared_mapping_t & operator= ( shared_mapping_t && ) = delete;
+    shared_mapping_t & operator= ( const shared_mapping_t & ) = delete;
+
+    ~shared_mapping_t ( ) noexcept {
+#if defined( _WIN32 )
+        if ( _data )
+            UnmapViewOfFile ( _data );
+        if ( _handle )
+            CloseHandle ( _handle );
+#else
+        if ( _data )
+            munmap ( _data, _size );
+#endif
+    }
+
+    // Removes the name (POSIX); the memory lives on while mapped.
+    static void unlink ( [[maybe_unused]] const char * name_ ) noexcept {
+#if not defined( _WIN32 )
+        shm_unlink ( name_ );
+#endif
+    }
+
+    [[nodiscard]] explicit operator bool ( ) const noexcept { return _data; }
+    [[nodiscard]] void * data ( ) const noexcept { return _data; }
+    [[nodiscard]] std::size_t size ( ) const noexcept { return _size; }
+
+    private:
+#if defined( _WIN32 )
+    HANDLE _handle = nullptr;
+#endif
+    void * _data = nullptr;
+    std::size_t _size;
+};
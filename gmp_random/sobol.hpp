@@ -0,0 +1,368 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <bit>
+#include <execution>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dispatch.hpp"
+#include "parallel_generate.hpp"
+#include "sobol_directions.hpp"
+
+// Sobol sequences, up to sobol_directions::dimensions dimensions, optionally
+// Owen-scrambled.
+//
+// Point n of the sequence is the xor of the direction numbers v_j of the set
+// bits j of the Gray code n ^ ( n >> 1 ); consecutive Gray codes differ in bit
+// ctz ( n ), so point n is point n - 1 with one direction number xored in, in
+// every dimension, and skip_to ( n ) is at most 64 rows of xors. The bulk path
+// writes a point, scrambled or not, and steps it to the next in one pass over
+// the dimensions, vectorized ( 64-bit multiplies and conversions AVX-512
+// natively, AVX2 from 32-bit ones ) and dispatched at runtime; all variants
+// write the same doubles. Point 0 is the origin. The direction numbers are 64
+// bits, the sequence has 2^64 points.
+//
+// Scrambling is Owen's nested uniform scramble by hashing ( Laine and Karras,
+// Burley ): with the bits of a coordinate reversed, a round of x += seed, x *=
+// odd or x ^= x * even changes bit i only as a function of the bits below it,
+// that is of the more significant bits of the coordinate, which is what nested
+// scrambling asks for. Each dimension hashes with its own seed, drawn from the
+// engine it is constructed with, a jsf64 seeded with the replicate number, say,
+// so the replicates are independent and reproducible. A scrambled sequence
+// keeps the stratification of the unscrambled one ( any 2^m points from index
+// k 2^m on fall one in each of the 2^m intervals of [ 0, 1 ), per dimension ).
+
+namespace sobol_detail {
+
+[[nodiscard]] constexpr std::uint64_t reverse_bits ( std::uint64_t x_ ) noexcept {
+    x_ = ( ( x_ >> 1 ) & 0x5555555555555555ULL ) | ( ( x_ & 0x5555555555555555ULL ) << 1 );
+    x_ = ( ( x_ >> 2 ) & 0x3333333333333333ULL ) | ( ( x_ & 0x3333333333333333ULL ) << 2 );
+    x_ = ( ( x_ >> 4 ) & 0x0f0f0f0f0f0f0f0fULL ) | ( ( x_ & 0x0f0f0f0f0f0f0f0fULL ) << 4 );
+    x_ = ( ( x_ >> 8 ) & 0x00ff00ff00ff00ffULL ) | ( ( x_ & 0x00ff00ff00ff00ffULL ) << 8 );
+    x_ = ( ( x_ >> 16 ) & 0x0000ffff0000ffffULL ) | ( ( x_ & 0x0000ffff0000ffffULL ) << 16 );
+    return ( x_ >> 32 ) | ( x_ << 32 );
+}
+
+// The nested uniform scramble of the coordinate x_ ( all 64 bits ) for seed_.
+[[nodiscard]] constexpr std::uint64_t scramble ( std::uint64_t x_, const std::uint64_t seed_ ) noexcept {
+    x_ = reverse_bits ( x_ );
+    x_ ^= x_ * 0x3d20adea6f1c3e4aULL;
+    x_ += seed_;
+    x_ *= ( seed_ >> 31 ) | 1;
+    x_ ^= x_ * 0x05526c569b7d2f18ULL;
+    x_ ^= x_ * 0x53a22864c4e1d7a6ULL;
+    x_ += seed_ >> 17;
+    x_ ^= x_ * 0xa3b195354a39b70eULL;
+    return reverse_bits ( x_ );
+}
+
+// x_ to [ 0, 1 ), its top 53 bits.
+[[nodiscard]] constexpr double to_double ( const std::uint64_t x_ ) noexcept { return double ( x_ >> 11 ) * 0x1p-53; }
+
+} // namespace sobol_detail
+
+class sobol {
+    public:
+    using result_type = std::uint64_t;
+
+    static constexpr std::size_t max_dimensions = sobol_directions::dimensions;
+    static constexpr int bits                   = 64;
+
+    // The ( unscrambled ) Sobol sequence in dimensions_ dimensions.
+    explicit sobol ( const std::size_t dimensions_ ) :
+        _dimensions ( dimensions_ ), _directions ( bits * dimensions_ ), _point ( dimensions_, 0 ) {
+        assert ( dimensions_ > 0 and dimensions_ <= max_dimensions );
+        for ( int j = 0; j < bits; ++j )
+            _directions[ j * dimensions_ ] = std::uint64_t{ 1 } << ( bits - 1 - j );
+        for ( std::size_t d = 1; d < dimensions_; ++d ) {
+            const auto & entry = sobol_directions::value[ d - 1 ];
+            const int s        = std::bit_width ( unsigned ( entry.polynomial ) ) - 1;
+            for ( int j = 0; j < bits; ++j ) {
+                std::uint64_t v;
+                if ( j < s ) {
+                    v = std::uint64_t ( entry.m_init[ j ] ) << ( bits - 1 - j );
+                }
+                else {
+                    // m_k = 2^s m_k-s ^ m_k-s ^ 2^i a_i m_k-i, i = 1 .. s - 1, a_i the
+                    // coefficient of x^( s - i ); v_k = m_k 2^-k.
+                    v = direction ( j - s, d );
+                    v ^= v >> s;
+                    for ( int i = 1; i < s; ++i )
+                        if ( ( entry.polynomial >> ( s - i ) ) & 1 )
+                            v ^= direction ( j - i, d );
+                }
+                _directions[ j * dimensions_ + d ] = v;
+            }
+        }
+    }
+
+    // The Owen-scrambled Sobol sequence in dimensions_ dimensions, a seed per
+    // dimension drawn from engine_.
+    template<typename Engine>
+    sobol ( const std::size_t dimensions_, Engine & engine_ ) : sobol ( dimensions_ ) {
+        _seeds.resize ( dimensions_ );
+        for ( std::uint64_t & seed : _seeds )
+            seed = rng::draw_key ( engine_ );
+    }
+
+    [[nodiscard]] std::size_t dimensions ( ) const noexcept { return _dimensions; }
+    [[nodiscard]] bool scrambled ( ) const noexcept { return not _seeds.empty ( ); }
+
+    // The index of the next point.
+    [[nodiscard]] std::uint64_t index ( ) const noexcept { return _index; }
+
+    // Makes point index_ the next one, in O ( dimensions ) time.
+    void skip_to ( const std::uint64_t index_ ) noexcept {
+        _index = index_;
+        gray_point ( index_, _point.data ( ) );
+    }
+
+    // Fills out_, out_.size ( ) / dimensions ( ) points, their coordinates in
+    // order, with the next points.
+    void fill_points ( const std::span<double> out_ ) {
+        assert ( out_.size ( ) % _dimensions == 0 );
+        const std::uint64_t n = out_.size ( ) / _dimensions;
+        fill ( _index, _point.data ( ), out_.data ( ), n );
+        _index += n;
+    }
+
+    // Fills out_ with the points index_, index_ + 1, ..., leaving the
+    // generator as it is ( the parallel path ).
+    void fill_points ( const std::uint64_t index_, const std::span<double> out_ ) const {
+        assert ( out_.size ( ) % _dimensions == 0 );
+        std::vector<std::uint64_t> point ( _dimensions );
+        gray_point ( index_, point.data ( ) );
+        fill ( index_, point.data ( ), out_.data ( ), out_.size ( ) / _dimensions );
+    }
+
+    private:
+    std::size_t _dimensions;
+    std::vector<std::uint64_t> _directions; // v_j of dimension d at j * _dimensions + d.
+    std::vector<std::uint64_t> _seeds;      // Empty if not scrambled.
+    std::vector<std::uint64_t> _point;      // The coordinates of point _index.
+    std::uint64_t _index = 0;
+
+    [[nodiscard]] std::uint64_t direction ( const int j_, const std::size_t d_ ) const noexcept {
+        return _directions[ j_ * _dimensions + d_ ];
+    }
+
+    void gray_point ( const std::uint64_t index_, std::uint64_t * const point_ ) const noexcept {
+        std::fill_n ( point_, _dimensions, std::uint64_t{ 0 } );
+        for ( std::uint64_t g = index_ ^ ( index_ >> 1 ); g; g &= g - 1 ) {
+            const std::uint64_t * const v = _directions.data ( ) + std::countr_zero ( g ) * _dimensions;
+            for ( std::size_t d = 0; d < _dimensions; ++d )
+                point_[ d ] ^= v[ d ];
+        }
+    }
+
+    // Writes the n_ coordinates of point_ to out_, scrambled with seeds_ unless
+    // that's nullptr, and xors v_ into point_.
+    using row_kernel = void ( * ) ( std::uint64_t *, const std::uint64_t *, const std::uint64_t *, double *, std::size_t ) noexcept;
+
+    // Writes the n_ points from index_ on, point_ holding point index_, and
+    // leaves point index_ + n_ in point_.
+    void fill ( std::uint64_t index_, std::uint64_t * const point_, double * out_, const std::uint64_t n_ ) const noexcept {
+        const row_kernel row              = kernel ( );
+        const std::uint64_t * const seeds = scrambled ( ) ? _seeds.data ( ) : nullptr;
+        for ( std::uint64_t i = 0; i < n_; ++i, out_ += _dimensions )
+            row ( point_, _directions.data ( ) + std::countr_zero ( ++index_ ) * _dimensions, seeds, out_, _dimensions );
+    }
+
+    [[nodiscard]] static row_kernel kernel ( ) noexcept {
+        static kernel_slot<row_kernel, 3> slot (
+            "sobol",
+            { { { "avx512", [ ]( const cpu_features & c_ ) { return c_.avx512dq; }, GMP_RANDOM_X86_ONLY ( row_avx512 ) },
+                { "avx2", [ ]( const cpu_features & c_ ) { return c_.avx2; }, GMP_RANDOM_X86_ONLY ( row_avx2 ) },
+                { "portable", always_supported, row_portable } } } );
+        return slot.get ( );
+    }
+
+    static void row_portable ( std::uint64_t * __restrict point_, const std::uint64_t * __restrict v_,
+                               const std::uint64_t * __restrict seeds_, double * __restrict out_, const std::size_t n_ ) noexcept {
+        for ( std::size_t d = 0; d < n_; ++d ) {
+            out_[ d ] = sobol_detail::to_double ( seeds_ ? sobol_detail::scramble ( point_[ d ], seeds_[ d ] ) : point_[ d ] );
+            point_[ d ] ^= v_[ d ];
+        }
+    }
+
+#if defined( GMP_RANDOM_X86 )
+    // Swaps the bits of x_ selected by mask_ with those S above them.
+    template<unsigned S>
+    GMP_RANDOM_TARGET ( "avx512f,avx512dq" )
+    static __m512i swap_avx512 ( const __m512i x_, const std::uint64_t mask_ ) noexcept {
+        const __m512i m = _mm512_set1_epi64 ( std::int64_t ( mask_ ) );
+        return _mm512_or_si512 ( _mm512_and_si512 ( _mm512_srli_epi64 ( x_, S ), m ), _mm512_slli_epi64 ( _mm512_and_si512 ( x_, m ), S ) );
+    }
+
+    GMP_RANDOM_TARGET ( "avx512f,avx512dq" )
+    static __m512i mul_avx512 ( const __m512i x_, const std::uint64_t c_ ) noexcept {
+        return _mm512_mullo_epi64 ( x_, _mm512_set1_epi64 ( std::int64_t ( c_ ) ) );
+    }
+
+    GMP_RANDOM_TARGET ( "avx512f,avx512dq" )
+    static __m512i reverse_avx512 ( __m512i x_ ) noexcept {
+        x_ = swap_avx512<1> ( x_, 0x5555555555555555ULL );
+        x_ = swap_avx512<2> ( x_, 0x3333333333333333ULL );
+        x_ = swap_avx512<4> ( x_, 0x0f0f0f0f0f0f0f0fULL );
+        x_ = swap_avx512<8> ( x_, 0x00ff00ff00ff00ffULL );
+        x_ = swap_avx512<16> ( x_, 0x0000ffff0000ffffULL );
+        return _mm512_ror_epi64 ( x_, 32 );
+    }
+
+    GMP_RANDOM_TARGET ( "avx512f,avx512dq" )
+    static __m512i scramble_avx512 ( __m512i x_, const __m512i seed_ ) noexcept {
+        x_ = reverse_avx512 ( x_ );
+        x_ = _mm512_xor_si512 ( x_, mul_avx512 ( x_, 0x3d20adea6f1c3e4aULL ) );
+        x_ = _mm512_add_epi64 ( x_, seed_ );
+        x_ = _mm512_mullo_epi64 ( x_, _mm512_or_si512 ( _mm512_srli_epi64 ( seed_, 31 ), _mm512_set1_epi64 ( 1 ) ) );
+        x_ = _mm512_xor_si512 ( x_, mul_avx512 ( x_, 0x05526c569b7d2f18ULL ) );
+        x_ = _mm512_xor_si512 ( x_, mul_avx512 ( x_, 0x53a22864c4e1d7a6ULL ) );
+        x_ = _mm512_add_epi64 ( x_, _mm512_srli_epi64 ( seed_, 17 ) );
+        x_ = _mm512_xor_si512 ( x_, mul_avx512 ( x_, 0xa3b195354a39b70eULL ) );
+        return reverse_avx512 ( x_ );
+    }
+
+    GMP_RANDOM_TARGET ( "avx512f,avx512dq" )
+    static void row_avx512 ( std::uint64_t * __restrict point_, const std::uint64_t * __restrict v_,
+                             const std::uint64_t * __restrict seeds_, double * __restrict out_, const std::size_t n_ ) noexcept {
+        const __m512d unit = _mm512_set1_pd ( 0x1p-53 );
+        std::size_t d      = 0;
+        for ( ; d + 8 <= n_; d += 8 ) {
+            __m512i x = _mm512_loadu_si512 ( point_ + d );
+            _mm512_storeu_si512 ( point_ + d, _mm512_xor_si512 ( x, _mm512_loadu_si512 ( v_ + d ) ) );
+            if ( seeds_ )
+                x = scramble_avx512 ( x, _mm512_loadu_si512 ( seeds_ + d ) );
+            _mm512_storeu_pd ( out_ + d, _mm512_mul_pd ( _mm512_cvtepu64_pd ( _mm512_srli_epi64 ( x, 11 ) ), unit ) );
+        }
+        row_portable ( point_ + d, v_ + d, seeds_ ? seeds_ + d : nullptr, out_ + d, n_ - d );
+    }
+
+    template<int S>
+    GMP_RANDOM_TARGET ( "avx2" )
+    static __m256i swap_avx2 ( const __m256i x_, const std::uint64_t mask_ ) noexcept {
+        const __m256i m = _mm256_set1_epi64x ( std::int64_t ( mask_ ) );
+        return _mm256_or_si256 ( _mm256_and_si256 ( _mm256_srli_epi64 ( x_, S ), m ), _mm256_slli_epi64 ( _mm256_and_si256 ( x_, m ), S ) );
+    }
+
+    GMP_RANDOM_TARGET ( "avx2" )
+    static __m256i reverse_avx2 ( __m256i x_ ) noexcept {
+        x_ = swap_avx2<1> ( x_, 0x5555555555555555ULL );
+        x_ = swap_avx2<2> ( x_, 0x3333333333333333ULL );
+        x_ = swap_avx2<4> ( x_, 0x0f0f0f0f0f0f0f0fULL );
+        x_ = swap_avx2<8> ( x_, 0x00ff00ff00ff00ffULL );
+        x_ = swap_avx2<16> ( x_, 0x0000ffff0000ffffULL );
+        return _mm256_shuffle_epi32 ( x_, 0xb1 );
+    }
+
+    // The low 64 bits of a 64 x 64 bit product: lo lo + ( lo hi + hi lo ) 2^32.
+    GMP_RANDOM_TARGET ( "avx2" )
+    static __m256i mullo_avx2 ( const __m256i a_, const __m256i b_ ) noexcept {
+        const __m256i cross = _mm256_add_epi64 ( _mm256_mul_epu32 ( a_, _mm256_srli_epi64 ( b_, 32 ) ),
+                                                 _mm256_mul_epu32 ( _mm256_srli_epi64 ( a_, 32 ), b_ ) );
+        return _mm256_add_epi64 ( _mm256_mul_epu32 ( a_, b_ ), _mm256_slli_epi64 ( cross, 32 ) );
+    }
+
+    GMP_RANDOM_TARGET ( "avx2" )
+    static __m256i mul_avx2 ( const __m256i x_, const std::uint64_t c_ ) noexcept {
+        return mullo_avx2 ( x_, _mm256_set1_epi64x ( std::int64_t ( c_ ) ) );
+    }
+
+    GMP_RANDOM_TARGET ( "avx2" )
+    static __m256i scramble_avx2 ( __m256i x_, const __m256i seed_ ) noexcept {
+        x_ = reverse_avx2 ( x_ );
+        x_ = _mm256_xor_si256 ( x_, mul_avx2 ( x_, 0x3d20adea6f1c3e4aULL ) );
+        x_ = _mm256_add_epi64 ( x_, seed_ );
+        x_ = mullo_avx2 ( x_, _mm256_or_si256 ( _mm256_srli_epi64 ( seed_, 31 ), _mm256_set1_epi64x ( 1 ) ) );
+        x_ = _mm256_xor_si256 ( x_, mul_avx2 ( x_, 0x05526c569b7d2f18ULL ) );
+        x_ = _mm256_xor_si256 ( x_, mul_avx2 ( x_, 0x53a22864c4e1d7a6ULL ) );
+        x_ = _mm256_add_epi64 ( x_, _mm256_srli_epi64 ( seed_, 17 ) );
+        x_ = _mm256_xor_si256 ( x_, mul_avx2 ( x_, 0xa3b195354a39b70eULL ) );
+        return reverse_avx2 ( x_ );
+    }
+
+    // x_ < 2^52 to double, through the 2^52 exponent.
+    GMP_RANDOM_TARGET ( "avx2" )
+    static __m256d exact_avx2 ( const __m256i x_ ) noexcept {
+        return _mm256_sub_pd ( _mm256_castsi256_pd ( _mm256_or_si256 ( x_, _mm256_set1_epi64x ( 0x4330000000000000LL ) ) ),
+                               _mm256_set1_pd ( 0x1p52 ) );
+    }
+
+    // The top 53 bits go to double exactly, as 2^21 ( x >> 32 ) + ( x >> 11 ) mod
+    // 2^21.
+    GMP_RANDOM_TARGET ( "avx2" )
+    static void row_avx2 ( std::uint64_t * __restrict point_, const std::uint64_t * __restrict v_,
+                           const std::uint64_t * __restrict seeds_, double * __restrict out_, const std::size_t n_ ) noexcept {
+        const __m256i low_mask = _mm256_set1_epi64x ( 0x1fffff );
+        const __m256d two21 = _mm256_set1_pd ( 0x1p21 ), unit = _mm256_set1_pd ( 0x1p-53 );
+        std::size_t d       = 0;
+        for ( ; d + 4 <= n_; d += 4 ) {
+            __m256i x = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( point_ + d ) );
+            _mm256_storeu_si256 ( reinterpret_cast<__m256i *> ( point_ + d ),
+                                  _mm256_xor_si256 ( x, _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( v_ + d ) ) ) );
+            if ( seeds_ )
+                x = scramble_avx2 ( x, _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( seeds_ + d ) ) );
+            const __m256d high = exact_avx2 ( _mm256_srli_epi64 ( x, 32 ) ),
+                          low  = exact_avx2 ( _mm256_and_si256 ( _mm256_srli_epi64 ( x, 11 ), low_mask ) );
+            _mm256_storeu_pd ( out_ + d, _mm256_mul_pd ( _mm256_add_pd ( _mm256_mul_pd ( high, two21 ), low ), unit ) );
+        }
+        row_portable ( point_ + d, v_ + d, seeds_ ? seeds_ + d : nullptr, out_ + d, n_ - d );
+    }
+#endif
+};
+
+namespace rng {
+
+// Points are filled in chunks of sobol_chunk_size, each from its own skip_to.
+inline constexpr std::size_t sobol_chunk_size = 4'096;
+
+// Fills out_ with the next out_.size ( ) / dimensions ( ) points of sobol_, and
+// moves it past them; the points are those of sobol_.fill_points ( out_ ), for
+// every policy.
+template<typename ExecutionPolicy, typename = std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+void fill_points ( ExecutionPolicy && policy_, sobol & sobol_, const std::span<double> out_ ) {
+    const std::size_t dims = sobol_.dimensions ( ), n = out_.size ( ) / dims;
+    const std::uint64_t first = sobol_.index ( );
+    assert ( out_.size ( ) % dims == 0 );
+    std::vector<std::size_t> chunks ( ( n + sobol_chunk_size - 1 ) / sobol_chunk_size );
+    std::iota ( chunks.begin ( ), chunks.end ( ), std::size_t{ 0 } );
+    std::for_each ( std::forward<ExecutionPolicy> ( policy_ ), chunks.begin ( ), chunks.end ( ), [ & ]( const std::size_t k ) {
+        const std::size_t begin = k * sobol_chunk_size, end = std::min ( n, begin + sobol_chunk_size );
+        std::as_const ( sobol_ ).fill_points ( first + begin, out_.subspan ( begin * dims, ( end - begin ) * dims ) );
+    } );
+    sobol_.skip_to ( first + n );
+}
+
+inline void fill_points ( sobol & sobol_, const std::span<double> out_ ) { sobol_.fill_points ( out_ ); }
+
+} // namespace rng
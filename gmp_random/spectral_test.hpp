@@ -0,0 +1,295 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <algorithm>
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gmpxx.h>
+
+#include "parallel_generate.hpp"
+
+// Spectral test for multiplicative congruential generators x' = a * x mod 2^k.
+//
+// The t-dimensional points ( x_n, ..., x_n+t-1 ) lie on a lattice; the
+// distance between adjacent covering hyperplanes is 1 / nu_t, where nu_t is
+// the length of the shortest non-zero vector of the dual lattice, spanned by
+// ( m, 0, ..., 0 ), ( -a, 1, 0, ... ), ( -a^2, 0, 1, ... ), ... The basis is
+// LLL-reduced and nu_t is then found exactly by Fincke-Pohst enumeration, all
+// in GMP arithmetic, so k is not limited to the width of a machine word.
+
+namespace spectral_detail {
+
+using basis_t = std::vector<std::vector<mpz_class>>;
+
+// Hermite's constants gamma_t ^ t, t = 2 .. 8.
+inline constexpr double hermite_pow[ 9 ] = { 0.0, 0.0, 4.0 / 3.0, 2.0, 4.0, 8.0, 64.0 / 3.0, 64.0, 256.0 };
+
+[[nodiscard]] inline mpz_class dot ( const std::vector<mpz_class> & a_, const std::vector<mpz_class> & b_ ) {
+    mpz_class r = 0;
+    for ( std::size_t i = 0; i < a_.size ( ); ++i )
+        r += a_[ i ] * b_[ i ];
+    return r;
+}
+
+[[nodiscard]] inline mpz_class round ( const mpf_class & f_ ) {
+    mpf_class h = f_ + 0.5;
+    mpz_class r;
+    mpz_set_f ( r.get_mpz_t ( ), mpf_class ( floor ( h ) ).get_mpf_t ( ) );
+    return r;
+}
+
+struct gso_t {
+    std::vector<std::vector<mpf_class>> mu;
+    std::vector<mpf_class> b; // |b*_i|^2.
+
+    gso_t ( const basis_t & basis_, const mp_bitcnt_t prec_ ) {
+        const std::size_t n = basis_.size ( );
+        mu.assign ( n, std::vector<mpf_class> ( n, mpf_class ( 0, prec_ ) ) );
+        b.assign ( n, mpf_class ( 0, prec_ ) );
+        std::vector<std::vector<mpf_class>> bs ( n, std::vector<mpf_class> ( n, mpf_class ( 0, prec_ ) ) );
+        for ( std::size_t i = 0; i < n; ++i ) {
+            for ( std::size_t k = 0; k < n; ++k )
+                bs[ i ][ k ] = basis_[ i ][ k ];
+            for ( std::size_t j = 0; j < i; ++j ) {
+                mpf_class d ( 0, prec_ );
+                for ( std::size_t k = 0; k < n; ++k )
+                    d += mpf_class ( basis_[ i ][ k ], prec_ ) * bs[ j ][ k ];
+                mu[ i ][ j ] = d / b[ j ];
+                for ( std::size_t k = 0; k < n; ++k )
+                    bs[ i ][ k ] -= mu[ i ][ j ] * bs[ j ][ k ];
+            }
+            for ( std::size_t k = 0; k < n; ++k )
+                b[ i ] += bs[ i ][ k ] * bs[ i ][ k ];
+        }
+    }
+};
+
+// LLL reduction (delta = 0.99) with incremental Gram-Schmidt updates.
+inline void lll ( basis_t & basis_, gso_t & g_, const mp_bitcnt_t prec_ ) {
+    const std::size_t n = basis_.size ( );
+    const mpf_class delta ( 0.99, prec_ ), half ( 0.5, prec_ );
+    auto reduce = [ & ]( std::size_t k, std::size_t l ) {
+        if ( abs ( g_.mu[ k ][ l ] ) > half ) {
+            const mpz_class r = round ( g_.mu[ k ][ l ] );
+            const mpf_class rf ( r, prec_ );
+            for ( std::size_t i = 0; i < n; ++i )
+                basis_[ k ][ i ] -= r * basis_[ l ][ i ];
+            for ( std::size_t j = 0; j < l; ++j )
+                g_.mu[ k ][ j ] -= rf * g_.mu[ l ][ j ];
+            g_.mu[ k ][ l ] -= rf;
+        }
+    };
+    std::size_t k = 1;
+    while ( k < n ) {
+        reduce ( k, k - 1 );
+        if ( g_.b[ k ] < ( delta - g_.mu[ k ][ k - 1 ] * g_.mu[ k ][ k - 1 ] ) * g_.b[ k - 1 ] ) {
+            const mpf_class m = g_.mu[ k ][ k - 1 ];
+            const mpf_class b = g_.b[ k ] + m * m * g_.b[ k - 1 ];
+            g_.mu[ k ][ k - 1 ] = m * g_.b[ k - 1 ] / b;
+            g_.b[ k ]           = g_.b[ k - 1 ] * g_.b[ k ] / b;
+            g_.b[ k - 1 ]       = b;
+            std::swap ( basis_[ k ], basis_[ k - 1 ] );
+            for ( std::size_t j = 0; j + 1 < k; ++j )
+                std::swap ( g_.mu[ k ][ j ], g_.mu[ k - 1 ][ j ] );
+            for ( std::size_t i = k + 1; i < n; ++i ) {
+                const mpf_class t = g_.mu[ i ][ k ];
+                g_.mu[ i ][ k ]     = g_.mu[ i ][ k - 1 ] - m * t;
+                g_.mu[ i ][ k - 1 ] = t + g_.mu[ k ][ k - 1 ] * g_.mu[ i ][ k ];
+            }
+            k = std::max<std::size_t> ( 1, k - 1 );
+        }
+        else {
+            for ( std::size_t l = k - 1; l-- > 0; )
+                reduce ( k, l );
+            ++k;
+        }
+    }
+}
+
+// Fincke-Pohst enumeration of the lattice vectors no longer than the shortest
+// basis vector, returns the squared length of the shortest non-zero one.
+[[nodiscard]] inline mpz_class shortest ( const basis_t & basis_, const mp_bitcnt_t prec_ ) {
+    const std::size_t n = basis_.size ( );
+    gso_t g ( basis_, prec_ );
+    mpz_class best = dot ( basis_[ 0 ], basis_[ 0 ] );
+    for ( std::size_t i = 1; i < n; ++i )
+        best = std::min ( best, dot ( basis_[ i ], basis_[ i ] ) );
+    std::vector<mpz_class> x ( n ), v ( n );
+    std::vector<mpf_class> c ( n, mpf_class ( 0, prec_ ) ), l ( n + 1, mpf_class ( 0, prec_ ) );
+    auto recurse = [ & ]( auto & self, std::size_t i ) -> void {
+        c[ i ] = 0;
+        for ( std::size_t j = i + 1; j < n; ++j )
+            c[ i ] -= mpf_class ( x[ j ], prec_ ) * g.mu[ j ][ i ];
+        const mpf_class budget = ( mpf_class ( best, prec_ ) - l[ i + 1 ] ) / g.b[ i ];
+        if ( budget < 0 )
+            return;
+        const mpf_class r = sqrt ( budget );
+        mpz_class lo, hi;
+        mpz_set_f ( lo.get_mpz_t ( ), mpf_class ( ceil ( mpf_class ( c[ i ] - r ) ) ).get_mpf_t ( ) );
+        mpz_set_f ( hi.get_mpz_t ( ), mpf_class ( floor ( mpf_class ( c[ i ] + r ) ) ).get_mpf_t ( ) );
+        for ( x[ i ] = lo; x[ i ] <= hi; ++x[ i ] ) {
+            const mpf_class d = mpf_class ( x[ i ], prec_ ) - c[ i ];
+            l[ i ]            = l[ i + 1 ] + d * d * g.b[ i ];
+            if ( i )
+                self ( self, i - 1 );
+            else if ( std::any_of ( x.begin ( ), x.end ( ), []( const mpz_class & z ) { return z != 0; } ) ) {
+                std::fill ( v.begin ( ), v.end ( ), 0 );
+                for ( std::size_t j = 0; j < n; ++j )
+                    for ( std::size_t k = 0; k < n; ++k )
+                        v[ k ] += x[ j ] * basis_[ j ][ k ];
+                best = std::min ( best, dot ( v, v ) );
+            }
+        }
+    };
+    recurse ( recurse, n - 1 );
+    return best;
+}
+
+} // namespace spectral_detail
+
+// Normalized spectral test figure of merit nu_t / ( gamma_t^1/2 * m^1/t ), in ( 0, 1 ],
+// of multiplier a_ for the modulus 2^bits_ in dimension t_.
+[[nodiscard]] inline double spectral_merit ( const mpz_class & a_, const std::size_t bits_, const std::size_t t_ ) {
+    using namespace spectral_detail;
+    assert ( t_ >= 2 and t_ <= 8 );
+    const mp_bitcnt_t prec = 2 * bits_ + 128;
+    mpz_class m;
+    mpz_ui_pow_ui ( m.get_mpz_t ( ), 2, bits_ );
+    basis_t basis ( t_, std::vector<mpz_class> ( t_, 0 ) );
+    basis[ 0 ][ 0 ] = m;
+    mpz_class p     = 1;
+    for ( std::size_t i = 1; i < t_; ++i ) {
+        p               = ( p * a_ ) % m;
+        basis[ i ][ 0 ] = m - p;
+        basis[ i ][ i ] = 1;
+    }
+    gso_t g ( basis, prec );
+    lll ( basis, g, prec );
+    const mpz_class nu2 = shortest ( basis, prec );
+    long e              = 0;
+    const double d      = mpz_get_d_2exp ( &e, nu2.get_mpz_t ( ) );
+    const double lg     = std::log2 ( d ) + e - std::log2 ( hermite_pow[ t_ ] ) / t_ - 2.0 * bits_ / t_;
+    return std::exp2 ( lg / 2.0 );
+}
+
+// The minimum of spectral_merit over dimensions 2 .. max_t_.
+[[nodiscard]] inline double spectral_figure_of_merit ( const mpz_class & a_, const std::size_t bits_, const std::size_t max_t_ = 8 ) {
+    double merit = 1.0;
+    for ( std::size_t t = 2; t <= max_t_; ++t )
+        merit = std::min ( merit, spectral_merit ( a_, bits_, t ) );
+    return merit;
+}
+
+struct vetted_multiplier_t {
+    double merit;
+    std::vector<std::uint64_t> limbs;
+};
+
+// Tests candidates_ random multipliers of limbs_ 64-bit limbs (a = 5 mod 8, the
+// full period class) against the modulus 2^( 64 * limbs_ ) on threads_ threads,
+// and returns the keep_ best. Candidate i is drawn from an Engine seeded with
+// substream i of seed_ and limbs_, so a search is reproducible whatever the
+// thread count, and the tables of different widths are independent.
+template<typename Engine>
+[[nodiscard]] std::vector<vetted_multiplier_t> search_multipliers ( const std::size_t limbs_, const std::size_t candidates_,
+                                                                    const std::size_t keep_, const std::size_t max_t_ = 8,
+                                                                    const std::uint64_t seed_   = 0xcafe5eed00000001ULL,
+                                                                    unsigned int threads_ = std::thread::hardware_concurrency ( ) ) {
+    std::atomic<std::size_t> next{ 0 };
+    std::vector<std::vector<vetted_multiplier_t>> found ( std::max ( 1u, threads_ ) );
+    auto work = [ & ]( std::vector<vetted_multiplier_t> & out_ ) {
+        for ( std::size_t i = next++; i < candidates_; i = next++ ) {
+            Engine gen ( rng::substream_seed ( rng::splitmix64 ( seed_ ^ limbs_ ), i ) );
+            vetted_multiplier_t c{ 0.0, std::vector<std::uint64_t> ( limbs_ ) };
+            for ( auto & l : c.limbs )
+                l = gen ( );
+            c.limbs[ 0 ] = ( c.limbs[ 0 ] & ~std::uint64_t ( 7 ) ) | 5;
+            mpz_class a;
+            mpz_import ( a.get_mpz_t ( ), limbs_, -1, sizeof ( std::uint64_t ), 0, 0, c.limbs.data ( ) );
+            c.merit = spectral_figure_of_merit ( a, 64 * limbs_, max_t_ );
+            out_.push_back ( std::move ( c ) );
+        }
+    };
+    std::vector<std::thread> pool;
+    for ( auto & f : found )
+        pool.emplace_back ( work, std::ref ( f ) );
+    for ( auto & t : pool )
+        t.join ( );
+    std::vector<vetted_multiplier_t> all;
+    for ( auto & f : found )
+        all.insert ( all.end ( ), f.begin ( ), f.end ( ) );
+    std::sort ( all.begin ( ), all.end ( ), []( const auto & a, const auto & b ) { return a.merit > b.merit; } );
+    all.resize ( std::min ( keep_, all.size ( ) ) );
+    return all;
+}
+
+// Writes a vetted_multipliers<Limbs> specialization, the format of multipliers.hpp.
+inline void emit_multiplier_table ( std::ostream & out_, const std::vector<vetted_multiplier_t> & table_ ) {
+    if ( table_.empty ( ) )
+        return;
+    const std::size_t limbs = table_.front ( ).limbs.size ( );
+    out_ << "\ntemplate<>\nstruct vetted_multipliers<" << limbs << "> {\n";
+    out_ << "    static constexpr std::size_t size = " << table_.size ( ) << ";\n";
+    out_ << "    static constexpr double merit[ size ] = {";
+    for ( std::size_t i = 0; i < table_.size ( ); ++i )
+        out_ << ( i ? ", " : " " ) << table_[ i ].merit;
+    out_ << " };\n";
+    out_ << "    static constexpr mp_limb_t value[ size ][ " << limbs << " ] = {\n";
+    char buf[ 24 ];
+    for ( const auto & m : table_ ) {
+        out_ << "        {";
+        for ( std::size_t i = 0; i < limbs; ++i ) {
+            std::snprintf ( buf, sizeof ( buf ), "0x%016llxULL", static_cast<unsigned long long> ( m.limbs[ i ] ) );
+            out_ << ( i ? ", " : " " ) << buf;
+        }
+        out_ << " },\n";
+    }
+    out_ << "    };\n};\n";
+}
+
+// Writes a complete multipliers.hpp, one specialization per table; command_ is
+// the command line that generated it.
+inline void emit_multiplier_header ( std::ostream & out_, const std::string & command_,
+                                     const std::vector<std::vector<vetted_multiplier_t>> & tables_ ) {
+    out_ << "\n// Generated by `" << command_ << "`, do not edit.\n//\n"
+            "// vetted_multipliers<Limbs>::value holds multipliers of Limbs limbs, sorted by\n"
+            "// their spectral test figure of merit (dimensions 2 .. 8) for the modulus\n"
+            "// 2^( 64 * Limbs ), best first.\n\n"
+            "#pragma once\n\n#include <cstddef>\n\n#include <gmpxx.h>\n\n"
+            "template<std::size_t Limbs>\nstruct vetted_multipliers {\n    static constexpr std::size_t size = 0;\n};\n";
+    for ( const auto & t : tables_ )
+        emit_multiplier_table ( out_, t );
+}
@@ -0,0 +1,207 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <gmp.h>
+
+// Stream distances of Lehmer generators modulo a power of 2, x -> x m mod
+// 2^k, k = 64 Limbs, m odd: the odd residues split into cycles (the cosets
+// of the group generated by m), and a state's position on its cycle is a
+// 2-adic discrete log, found bit by bit ( Pohlig - Hellman in a 2-group ).
+//
+// With b = m^2 if m = 3 mod 4, m otherwise, and b = 1 + 2^v u, u odd, b^( 2^j )
+// is 1 + 2^( v + j ) u_j, u_j odd: multiplying by it flips bit v + j and
+// leaves the bits below alone. Clearing bits v .. k - 1 of x one at a time
+// that way takes x to the one state of its cycle below 2^v ( and 1 mod 4 ),
+// which names the cycle, and the powers divided out give its position. That's
+// k - v products of k bits, the inverse powers b^-( 2^j ) are computed once.
+
+template<std::size_t Limbs>
+class lehmer_cycles {
+    public:
+    using number_t = std::array<mp_limb_t, Limbs>;
+
+    static constexpr std::size_t bits = Limbs * GMP_NUMB_BITS;
+
+    // The cycle of a state ( its state below 2^v ) and the position on it,
+    // the steps from there.
+    struct location_t {
+        number_t cycle, position;
+
+        [[nodiscard]] bool operator== ( const location_t & ) const noexcept = default;
+    };
+
+    // The multiplier, of mn_ <= Limbs limbs, odd.
+    lehmer_cycles ( const mp_limb_t * m_, const std::size_t mn_ ) {
+        assert ( mn_ <= Limbs and m_[ 0 ] & 1 );
+        number_t m{ };
+        std::copy_n ( m_, mn_, m.data ( ) );
+        _square = m[ 0 ] & 2;
+        if ( _square ) {
+            _inverse = inverse ( m );
+            m        = mul ( m, m );
+        }
+        number_t b = m;
+        b[ 0 ] ^= 1;
+        _v = bits;
+        for ( std::size_t i = 0; i < Limbs; ++i )
+            if ( b[ i ] ) {
+                _v = i * GMP_NUMB_BITS + std::countr_zero ( b[ i ] );
+                break;
+            }
+        _powers.resize ( bits - _v );
+        if ( _powers.size ( ) )
+            _powers[ 0 ] = inverse ( m );
+        for ( std::size_t j = 1; j < _powers.size ( ); ++j )
+            _powers[ j ] = mul ( _powers[ j - 1 ], _powers[ j - 1 ] );
+    }
+
+    // The period is 2^log2_period ( ).
+    [[nodiscard]] std::size_t log2_period ( ) const noexcept { return bits - _v + _square; }
+
+    // x_ ( odd ) = cycle m^position.
+    [[nodiscard]] location_t locate ( const mp_limb_t * x_ ) const noexcept {
+        assert ( x_[ 0 ] & 1 );
+        location_t l{ };
+        number_t & x = l.cycle;
+        std::copy_n ( x_, Limbs, x.data ( ) );
+        if ( _square and x[ 0 ] & 2 ) {
+            x                 = mul ( x, _inverse );
+            l.position[ 0 ] = 1;
+        }
+        for ( std::size_t j = 0; j < _powers.size ( ); ++j ) {
+            const std::size_t bit = _v + j, p = j + _square;
+            if ( x[ bit / GMP_NUMB_BITS ] >> bit % GMP_NUMB_BITS & 1 ) {
+                x = mul ( x, _powers[ j ] );
+                l.position[ p / GMP_NUMB_BITS ] |= mp_limb_t{ 1 } << p % GMP_NUMB_BITS;
+            }
+        }
+        return l;
+    }
+
+    // The number of steps from a_ to b_, or nothing if they are on different
+    // cycles.
+    [[nodiscard]] std::optional<number_t> distance ( const mp_limb_t * a_, const mp_limb_t * b_ ) const noexcept {
+        const location_t a = locate ( a_ ), b = locate ( b_ );
+        if ( a.cycle != b.cycle )
+            return std::nullopt;
+        return difference ( b.position, a.position );
+    }
+
+    // a_ - b_ mod the period.
+    [[nodiscard]] number_t difference ( const number_t & a_, const number_t & b_ ) const noexcept {
+        number_t d;
+        mpn_sub_n ( d.data ( ), a_.data ( ), b_.data ( ), Limbs );
+        const std::size_t e = log2_period ( );
+        for ( std::size_t i = e / GMP_NUMB_BITS; i < Limbs; ++i )
+            d[ i ] &= i == e / GMP_NUMB_BITS ? ( mp_limb_t{ 1 } << e % GMP_NUMB_BITS ) - 1 : 0;
+        return d;
+    }
+
+    private:
+    // a_ b_ mod 2^bits.
+    [[nodiscard]] static number_t mul ( const number_t & a_, const number_t & b_ ) noexcept {
+        std::array<mp_limb_t, 2 * Limbs> p;
+        mpn_mul_n ( p.data ( ), a_.data ( ), b_.data ( ), Limbs );
+        number_t r;
+        std::copy_n ( p.data ( ), Limbs, r.data ( ) );
+        return r;
+    }
+
+    // m_^-1 mod 2^bits: Newton's iteration, x ( 2 - m x ), from the 3 bits of
+    // x = m, doubles the correct bits each step.
+    [[nodiscard]] static number_t inverse ( const number_t & m_ ) noexcept {
+        number_t x = m_, two{ };
+        two[ 0 ]   = 2;
+        for ( std::size_t b = 3; b < bits; b *= 2 ) {
+            number_t t = mul ( m_, x );
+            mpn_sub_n ( t.data ( ), two.data ( ), t.data ( ), Limbs );
+            x = mul ( x, t );
+        }
+        return x;
+    }
+
+    number_t _inverse{ };             // m^-1, if _square.
+    std::vector<number_t> _powers;    // b^-( 2^j ).
+    std::size_t _v = 0;               // b = 1 + 2^_v u.
+    bool _square   = false;           // m = 3 mod 4, b = m^2.
+};
+
+// An allocation of substreams: each starts at a state and runs for a number of
+// steps. overlapping_streams returns the pairs ( i, j ), i < j, of streams
+// that share a state, in O ( n log n ) ( plus the pairs ): sorted by cycle and
+// position, a stream can only overlap the ones following it ( cyclically )
+// within its length.
+template<std::size_t Limbs>
+struct stream_t {
+    typename lehmer_cycles<Limbs>::location_t start;
+    std::uint64_t steps;
+};
+
+template<std::size_t Limbs>
+[[nodiscard]] std::vector<std::pair<std::size_t, std::size_t>>
+overlapping_streams ( const lehmer_cycles<Limbs> & cycles_, const std::vector<stream_t<Limbs>> & streams_ ) {
+    std::vector<std::size_t> order ( streams_.size ( ) );
+    for ( std::size_t i = 0; i < order.size ( ); ++i )
+        order[ i ] = i;
+    const auto less = [ & ]( const std::size_t a_, const std::size_t b_ ) {
+        const auto &a = streams_[ a_ ].start, &b = streams_[ b_ ].start;
+        if ( const int c = mpn_cmp ( a.cycle.data ( ), b.cycle.data ( ), Limbs ) )
+            return c < 0;
+        return mpn_cmp ( a.position.data ( ), b.position.data ( ), Limbs ) < 0;
+    };
+    std::sort ( order.begin ( ), order.end ( ), less );
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    for ( std::size_t first = 0, last = 0; first < order.size ( ); first = last ) {
+        const auto & cycle = streams_[ order[ first ] ].start.cycle;
+        for ( last = first + 1; last < order.size ( ) and streams_[ order[ last ] ].start.cycle == cycle; ++last )
+            ;
+        const std::size_t n = last - first;
+        for ( std::size_t i = 0; i < n; ++i ) {
+            const stream_t<Limbs> & s = streams_[ order[ first + i ] ];
+            for ( std::size_t k = 1; k < n; ++k ) {
+                const std::size_t j = order[ first + ( i + k ) % n ];
+                const auto d        = cycles_.difference ( streams_[ j ].start.position, s.start.position );
+                if ( std::any_of ( d.begin ( ) + 1, d.end ( ), [ ]( const mp_limb_t l_ ) { return l_; } ) or d[ 0 ] >= s.steps )
+                    break;
+                pairs.emplace_back ( std::minmax ( order[ first + i ], j ) );
+            }
+        }
+    }
+    std::sort ( pairs.begin ( ), pairs.end ( ) );
+    pairs.erase ( std::unique ( pairs.begin ( ), pairs.end ( ) ), pairs.end ( ) );
+    return pairs;
+}
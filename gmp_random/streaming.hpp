@@ -0,0 +1,86 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "dispatch.hpp"
+
+// Non-temporal (streaming) stores: copies that write around the caches, for
+// buffers that won't be read again soon, larger than the last level cache.
+// They don't read the destination lines for ownership first and don't evict
+// the working set. stream_copy wants a destination aligned to stream_alignment
+// and a size that's a multiple of it, stream_fence orders the streaming stores
+// before whatever follows (they are weakly ordered).
+
+inline constexpr std::size_t stream_alignment = 32;
+
+namespace streaming_detail {
+
+using copy_kernel = void ( * ) ( void * __restrict dst_, const void * __restrict src_, std::size_t bytes_ ) noexcept;
+
+inline void copy_portable ( void * __restrict dst_, const void * __restrict src_, const std::size_t bytes_ ) noexcept {
+    std::memcpy ( dst_, src_, bytes_ );
+}
+
+#if defined( GMP_RANDOM_X86 )
+GMP_RANDOM_TARGET ( "sse2" )
+inline void copy_sse2 ( void * __restrict dst_, const void * __restrict src_, const std::size_t bytes_ ) noexcept {
+    __m128i * d       = static_cast<__m128i *> ( dst_ );
+    const __m128i * s = static_cast<const __m128i *> ( src_ );
+    for ( std::size_t i = 0, n = bytes_ / 16; i < n; ++i )
+        _mm_stream_si128 ( d + i, _mm_loadu_si128 ( s + i ) );
+}
+
+GMP_RANDOM_TARGET ( "avx" )
+inline void copy_avx ( void * __restrict dst_, const void * __restrict src_, const std::size_t bytes_ ) noexcept {
+    __m256i * d       = static_cast<__m256i *> ( dst_ );
+    const __m256i * s = static_cast<const __m256i *> ( src_ );
+    for ( std::size_t i = 0, n = bytes_ / 32; i < n; ++i )
+        _mm256_stream_si256 ( d + i, _mm256_loadu_si256 ( s + i ) );
+}
+#endif
+
+[[nodiscard]] inline copy_kernel copy ( ) noexcept {
+    static kernel_slot<copy_kernel, 3> slot (
+        "stream copy", { { { "avx", [ ]( const cpu_features & c_ ) { return c_.avx; }, GMP_RANDOM_X86_ONLY ( copy_avx ) },
+                           { "sse2", [ ]( const cpu_features & c_ ) { return c_.sse2; }, GMP_RANDOM_X86_ONLY ( copy_sse2 ) },
+                           { "portable", always_supported, copy_portable } } } );
+    return slot.get ( );
+}
+
+} // namespace streaming_detail
+
+inline void stream_copy ( void * __restrict dst_, const void * __restrict src_, const std::size_t bytes_ ) noexcept {
+    streaming_detail::copy ( ) ( dst_, src_, bytes_ );
+}
+
+inline void stream_fence ( ) noexcept {
+#if defined( GMP_RANDOM_X86 )
+    _mm_sfence ( );
+#endif
+}
@@ -0,0 +1,113 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "dispatch.hpp"
+
+// Output functions of GMPRng2, applied to the limbs as they leave the state,
+// one at a time by operator ( ) and fused with the copy by generate.
+//
+// raw_output hands out the state limbs as they are. rxs_m_xs_output applies
+// PCG's RXS M XS permutation to every limb: a random (top-bit selected) xor
+// shift, a multiply and a fixed xor shift, a bijection that makes the low bits
+// of a limb depend on its high bits. The loop carries no dependency from one
+// limb to the next, the bulk apply is vectorized (variable shifts and 64-bit
+// multiplies, AVX-512 natively, AVX2 from 32-bit ones) and dispatched at
+// runtime. It adds a few cycles per limb to the mpn_mul that produced the
+// block, gmp_random bench tempering measures how many.
+
+struct raw_output {
+    [[nodiscard]] static constexpr std::uint64_t apply ( const std::uint64_t x_ ) noexcept { return x_; }
+    static void apply ( const std::uint64_t * __restrict in_, std::uint64_t * __restrict out_, const std::size_t n_ ) noexcept {
+        std::memcpy ( out_, in_, n_ * sizeof ( std::uint64_t ) );
+    }
+};
+
+struct rxs_m_xs_output {
+    static constexpr std::uint64_t multiplier = 12'605'985'483'714'917'081ULL;
+
+    [[nodiscard]] static constexpr std::uint64_t apply ( const std::uint64_t x_ ) noexcept {
+        const std::uint64_t w = ( ( x_ >> ( ( x_ >> 59 ) + 5 ) ) ^ x_ ) * multiplier;
+        return ( w >> 43 ) ^ w;
+    }
+    static void apply ( const std::uint64_t * __restrict in_, std::uint64_t * __restrict out_, const std::size_t n_ ) noexcept {
+        kernel ( ) ( in_, out_, n_ );
+    }
+
+    using apply_kernel = void ( * ) ( const std::uint64_t *, std::uint64_t *, std::size_t ) noexcept;
+
+    [[nodiscard]] static apply_kernel kernel ( ) noexcept {
+        static kernel_slot<apply_kernel, 3> slot (
+            "rxs_m_xs_output",
+            { { { "avx512", [ ]( const cpu_features & c_ ) { return c_.avx512dq; }, GMP_RANDOM_X86_ONLY ( apply_avx512 ) },
+                { "avx2", [ ]( const cpu_features & c_ ) { return c_.avx2; }, GMP_RANDOM_X86_ONLY ( apply_avx2 ) },
+                { "portable", always_supported, apply_portable } } } );
+        return slot.get ( );
+    }
+
+    static void apply_portable ( const std::uint64_t * __restrict in_, std::uint64_t * __restrict out_,
+                                 const std::size_t n_ ) noexcept {
+        for ( std::size_t i = 0; i < n_; ++i )
+            out_[ i ] = apply ( in_[ i ] );
+    }
+
+#if defined( GMP_RANDOM_X86 )
+    GMP_RANDOM_TARGET ( "avx512f,avx512dq" )
+    static void apply_avx512 ( const std::uint64_t * __restrict in_, std::uint64_t * __restrict out_,
+                               const std::size_t n_ ) noexcept {
+        const __m512i m = _mm512_set1_epi64 ( std::int64_t ( multiplier ) ), five = _mm512_set1_epi64 ( 5 );
+        std::size_t i   = 0;
+        for ( ; i + 8 <= n_; i += 8 ) {
+            const __m512i x = _mm512_loadu_si512 ( in_ + i );
+            const __m512i s = _mm512_add_epi64 ( _mm512_srli_epi64 ( x, 59 ), five );
+            const __m512i w = _mm512_mullo_epi64 ( _mm512_xor_si512 ( _mm512_srlv_epi64 ( x, s ), x ), m );
+            _mm512_storeu_si512 ( out_ + i, _mm512_xor_si512 ( _mm512_srli_epi64 ( w, 43 ), w ) );
+        }
+        apply_portable ( in_ + i, out_ + i, n_ - i );
+    }
+
+    // The low 64 bits of a 64 x 64 bit product: lo lo + ( lo hi + hi lo ) 2^32.
+    GMP_RANDOM_TARGET ( "avx2" )
+    static void apply_avx2 ( const std::uint64_t * __restrict in_, std::uint64_t * __restrict out_,
+                             const std::size_t n_ ) noexcept {
+        const __m256i m = _mm256_set1_epi64x ( std::int64_t ( multiplier ) ), m_high = _mm256_srli_epi64 ( m, 32 ),
+                      five = _mm256_set1_epi64x ( 5 );
+        std::size_t i   = 0;
+        for ( ; i + 4 <= n_; i += 4 ) {
+            const __m256i x     = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( in_ + i ) );
+            const __m256i s     = _mm256_add_epi64 ( _mm256_srli_epi64 ( x, 59 ), five );
+            const __m256i y     = _mm256_xor_si256 ( _mm256_srlv_epi64 ( x, s ), x );
+            const __m256i cross =
+                _mm256_add_epi64 ( _mm256_mul_epu32 ( y, m_high ), _mm256_mul_epu32 ( _mm256_srli_epi64 ( y, 32 ), m ) );
+            const __m256i w     = _mm256_add_epi64 ( _mm256_mul_epu32 ( y, m ), _mm256_slli_epi64 ( cross, 32 ) );
+            _mm256_storeu_si256 ( reinterpret_cast<__m256i *> ( out_ + i ), _mm256_xor_si256 ( _mm256_srli_epi64 ( w, 43 ), w ) );
+        }
+        apply_portable ( in_ + i, out_ + i, n_ - i );
+    }
+#endif
+};
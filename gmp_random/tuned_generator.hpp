@@ -0,0 +1,5 @@
+// Generated by `gmp_random autotune 28`, do not edit.
+
+#pragma once
+
+using tuned_generator = jsf64na;
@@ -0,0 +1,182 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "block.hpp"
+#include "parallel_generate.hpp"
+
+// Variance reduction: point sets in [ 0, 1 )^dims, written in bulk, the
+// coordinates of a point next to each other, from an engine's blocks (
+// block_buffer ), that estimate an integral ( the mean of f over the points )
+// with less variance than as many independent points.
+//
+// antithetic writes pairs of points u, 1 - u; the estimator's variance falls
+// by as much as f is monotone in u. stratified writes one point in each cell
+// of a grid of strata^dims equal cells. latin_hypercube writes n points that
+// fall one in each of n equal slabs along every axis, the slab of point i
+// along axis d being a random permutation of the points, which removes the
+// additive part of f from the variance. Its dimensions are independent: axis
+// d draws its permutation and jitter from its own engine, seeded with
+// substream d of one draw from the engine ( see rng::generate ), so they're
+// generated in parallel, and the points don't depend on the policy.
+//
+// The coordinates are the top 53 bits of an engine value ( all of them, for
+// engines of fewer bits ), and a permutation is a Fisher-Yates shuffle with
+// Lemire's bounded integers.
+
+namespace variance_detail {
+
+// Fills out_ with uniforms in [ 0, 1 ), a block at a time.
+template<typename Buffer>
+void uniforms ( Buffer & source_, double * out_, std::size_t n_ ) {
+    using result_type          = typename Buffer::result_type;
+    constexpr int bits         = std::numeric_limits<result_type>::digits;
+    constexpr std::size_t take = 64;
+    const double scale         = std::ldexp ( 1.0, -std::min ( bits, 53 ) );
+    while ( n_ ) {
+        const std::size_t m         = std::min ( n_, take );
+        const result_type * const x = source_.take ( m );
+        for ( std::size_t i = 0; i < m; ++i ) {
+            if constexpr ( bits > 53 )
+                out_[ i ] = double ( x[ i ] >> ( bits - 53 ) ) * scale;
+            else
+                out_[ i ] = double ( x[ i ] ) * scale;
+        }
+        out_ += m;
+        n_ -= m;
+    }
+}
+
+// 64 random bits, from one or two values.
+template<typename Buffer>
+[[nodiscard]] std::uint64_t bits64 ( Buffer & source_ ) {
+    if constexpr ( std::numeric_limits<typename Buffer::result_type>::digits < 64 ) {
+        const std::uint64_t hi = std::uint64_t ( source_ ( ) ) << 32;
+        return hi ^ std::uint64_t ( source_ ( ) );
+    }
+    else {
+        return std::uint64_t ( source_ ( ) );
+    }
+}
+
+// Uniform in [ 0, n_ ), Lemire's multiply and ( rarely ) reject.
+template<typename Buffer>
+[[nodiscard]] std::uint64_t bounded ( Buffer & source_, const std::uint64_t n_ ) {
+    __uint128_t m = __uint128_t{ bits64 ( source_ ) } * n_;
+    if ( std::uint64_t ( m ) < n_ ) {
+        const std::uint64_t threshold = ( 0 - n_ ) % n_;
+        while ( std::uint64_t ( m ) < threshold )
+            m = __uint128_t{ bits64 ( source_ ) } * n_;
+    }
+    return std::uint64_t ( m >> 64 );
+}
+
+// Axis d_ of the latin hypercube of out_.size ( ) / dims_ points, from engine_.
+template<typename Engine>
+void latin_axis ( Engine & engine_, const std::size_t dims_, const std::size_t d_, const std::span<double> out_ ) {
+    const std::size_t n = out_.size ( ) / dims_;
+    block_buffer<Engine> source ( engine_ );
+    std::vector<std::uint64_t> slab ( n );
+    std::iota ( slab.begin ( ), slab.end ( ), std::uint64_t{ 0 } );
+    for ( std::size_t i = n; i > 1; --i )
+        std::swap ( slab[ i - 1 ], slab[ bounded ( source, i ) ] );
+    std::vector<double> jitter ( n );
+    uniforms ( source, jitter.data ( ), n );
+    const double width = 1.0 / double ( n );
+    for ( std::size_t i = 0; i < n; ++i )
+        out_[ i * dims_ + d_ ] = ( double ( slab[ i ] ) + jitter[ i ] ) * width;
+}
+
+} // namespace variance_detail
+
+// Fills out_ with out_.size ( ) / ( 2 dims_ ) antithetic pairs of points, u and
+// 1 - u ( in ( 0, 1 ] ).
+template<typename Engine>
+void antithetic ( Engine & engine_, const std::size_t dims_, const std::span<double> out_ ) {
+    assert ( out_.size ( ) % ( 2 * dims_ ) == 0 );
+    block_buffer<Engine> source ( engine_ );
+    for ( double * p = out_.data ( ), * const end = p + out_.size ( ); p != end; p += 2 * dims_ ) {
+        variance_detail::uniforms ( source, p, dims_ );
+        for ( std::size_t d = 0; d < dims_; ++d )
+            p[ dims_ + d ] = 1.0 - p[ d ];
+    }
+}
+
+// Fills out_ with out_.size ( ) / dims_ points, point i in cell i ( mod
+// strata_^dims_ ) of the grid of strata_ equal strata along every axis, axis 0
+// fastest; strata_^dims_ points make one in each cell.
+template<typename Engine>
+void stratified ( Engine & engine_, const std::size_t dims_, const std::size_t strata_, const std::span<double> out_ ) {
+    assert ( strata_ > 0 and out_.size ( ) % dims_ == 0 );
+    block_buffer<Engine> source ( engine_ );
+    variance_detail::uniforms ( source, out_.data ( ), out_.size ( ) );
+    const double width = 1.0 / double ( strata_ );
+    std::vector<std::size_t> cell ( dims_, 0 );
+    for ( double * p = out_.data ( ), * const end = p + out_.size ( ); p != end; p += dims_ ) {
+        for ( std::size_t d = 0; d < dims_; ++d )
+            p[ d ] = ( double ( cell[ d ] ) + p[ d ] ) * width;
+        for ( std::size_t d = 0; d < dims_ and ++cell[ d ] == strata_; ++d )
+            cell[ d ] = 0;
+    }
+}
+
+namespace rng {
+
+// Fills out_ with a latin hypercube of out_.size ( ) / dims_ points, the axes
+// in parallel. The engine advances by one draw ( two for engines of less than
+// 64 bits ).
+template<typename ExecutionPolicy, typename Engine,
+         typename = std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+void latin_hypercube ( ExecutionPolicy && policy_, Engine & engine_, const std::size_t dims_, const std::span<double> out_ ) {
+    static_assert ( std::is_constructible_v<Engine, std::uint64_t>, "the engine has to be constructible from a 64-bit seed" );
+    assert ( out_.size ( ) % dims_ == 0 );
+    const std::uint64_t key = draw_key ( engine_ );
+    std::vector<std::size_t> axes ( dims_ );
+    std::iota ( axes.begin ( ), axes.end ( ), std::size_t{ 0 } );
+    std::for_each ( std::forward<ExecutionPolicy> ( policy_ ), axes.begin ( ), axes.end ( ), [ & ]( const std::size_t d ) {
+        Engine engine ( substream_seed ( key, d ) );
+        variance_detail::latin_axis ( engine, dims_, d, out_ );
+    } );
+}
+
+template<typename Engine>
+void latin_hypercube ( Engine & engine_, const std::size_t dims_, const std::span<double> out_ ) {
+    latin_hypercube ( std::execution::seq, engine_, dims_, out_ );
+}
+
+} // namespace rng
@@ -0,0 +1,182 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <execution>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "block.hpp"
+#include "parallel_generate.hpp"
+
+// Weighted reservoir sampling, Efraimidis and Spirakis' A-ExpJ.
+//
+// Item i gets the key u_i^( 1 / w_i ), u_i uniform, and the sample is the k
+// items of the largest keys ( kept as log u_i / w_i ). Once the reservoir is
+// full, with T its smallest key, the weight skipped before the next item
+// that gets in is exponential, log u / log T, so only the items that get in
+// take random numbers, three in all: the jump, and a key drawn in ( T, 1 ).
+// The uniforms are drawn from the engine a block at a time.
+//
+// The stream is cut into segments of segment_size items by index, and each
+// segment is sampled from scratch, with its own engine, seeded with substream
+// s of the root seed ( see rng::generate ). The sample is the k largest keys
+// of all of them, so the reservoirs of the shards of a stream merge into the
+// same sample however the stream was sharded, as long as every segment is
+// pushed whole, in order, into one reservoir. The shards hold runs of whole
+// segments, or any other division of them.
+
+template<typename T, typename Engine, std::size_t BlockSize = 256>
+class weighted_reservoir {
+    public:
+    struct entry_t {
+        double key; // log u / w.
+        std::uint64_t index;
+        T item;
+    };
+
+    weighted_reservoir ( const std::size_t k_, const std::uint64_t seed_, const std::uint64_t segment_size_ = std::uint64_t{ 1 } << 20 ) :
+        _k ( k_ ), _seed ( seed_ ), _segment_size ( segment_size_ ), _engine ( seed_ ) {
+        assert ( k_ > 0 and segment_size_ > 0 );
+    }
+
+    // Offers item_ of weight_ > 0, at index_ in the stream.
+    void push ( const std::uint64_t index_, const T & item_, const double weight_ ) {
+        assert ( weight_ > 0.0 );
+        if ( const std::uint64_t segment = index_ / _segment_size; not _started or segment != _segment )
+            start ( segment );
+        if ( _heap.size ( ) < _k ) {
+            _heap.push_back ( { std::log ( uniform ( ) ) / weight_, index_, item_ } );
+            std::push_heap ( _heap.begin ( ), _heap.end ( ), greater );
+            if ( _heap.size ( ) == _k )
+                jump ( );
+            return;
+        }
+        if ( ( _jump -= weight_ ) > 0.0 )
+            return;
+        // A key in ( T, 1 ), log T = _heap.front ( ).key.
+        const double t = std::exp ( _heap.front ( ).key * weight_ );
+        std::pop_heap ( _heap.begin ( ), _heap.end ( ), greater );
+        _heap.back ( ) = { std::log ( t + uniform ( ) * ( 1.0 - t ) ) / weight_, index_, item_ };
+        std::push_heap ( _heap.begin ( ), _heap.end ( ), greater );
+        jump ( );
+    }
+
+    // Adds the items of rhs_ to the sample.
+    void merge ( const weighted_reservoir & rhs_ ) {
+        _sample.insert ( _sample.end ( ), rhs_._sample.begin ( ), rhs_._sample.end ( ) );
+        _sample.insert ( _sample.end ( ), rhs_._heap.begin ( ), rhs_._heap.end ( ) );
+        truncate ( _sample );
+    }
+
+    // The sample, largest key first.
+    [[nodiscard]] std::vector<entry_t> sample ( ) const {
+        std::vector<entry_t> s = _sample;
+        s.insert ( s.end ( ), _heap.begin ( ), _heap.end ( ) );
+        truncate ( s );
+        std::sort ( s.begin ( ), s.end ( ), greater );
+        return s;
+    }
+
+    private:
+    std::size_t _k;
+    std::uint64_t _seed, _segment_size, _segment = 0; // The segment sampled, once _started.
+    bool _started = false;
+    Engine _engine;
+    std::size_t _index = BlockSize;
+    std::array<typename Engine::result_type, BlockSize> _block{ };
+    double _jump = 0.0;
+    std::vector<entry_t> _heap, _sample; // The segment's ( a min-heap ), the finished segments'.
+
+    // The larger key first, the lower index on a tie.
+    [[nodiscard]] static bool greater ( const entry_t & a_, const entry_t & b_ ) noexcept {
+        return a_.key > b_.key or ( a_.key == b_.key and a_.index < b_.index );
+    }
+
+    // To the k largest keys.
+    void truncate ( std::vector<entry_t> & s_ ) const {
+        if ( s_.size ( ) <= _k )
+            return;
+        std::nth_element ( s_.begin ( ), s_.begin ( ) + _k, s_.end ( ), greater );
+        s_.erase ( s_.begin ( ) + _k, s_.end ( ) );
+    }
+
+    void start ( const std::uint64_t segment_ ) {
+        _sample.insert ( _sample.end ( ), _heap.begin ( ), _heap.end ( ) );
+        truncate ( _sample );
+        _heap.clear ( );
+        _segment = segment_, _started = true;
+        _engine  = Engine ( rng::substream_seed ( _seed, segment_ ) );
+        _index   = BlockSize;
+    }
+
+    // The weight to skip, log u / log T.
+    void jump ( ) { _jump = std::log ( uniform ( ) ) / _heap.front ( ).key; }
+
+    // In ( 0, 1 ].
+    [[nodiscard]] double uniform ( ) {
+        if ( _index == BlockSize ) {
+            fill_block ( _engine, _block.data ( ), _block.data ( ) + BlockSize );
+            _index = 0;
+        }
+        return double ( ( std::uint64_t ( _block[ _index++ ] ) >> 11 ) + 1 ) * 0x1p-53;
+    }
+};
+
+namespace rng {
+
+// The weighted sample of k_ items of [ first_, last_ ), of weights weight_ (
+// item ), drawn with Engine, the segments sampled in parallel on policy_; the
+// same for every policy, and as a weighted_reservoir fed the whole range.
+template<typename Engine, typename ExecutionPolicy, typename RandomIt, typename Weight,
+         typename = std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+[[nodiscard]] auto weighted_sample ( ExecutionPolicy && policy_, const RandomIt first_, const RandomIt last_, const std::size_t k_,
+                                     const std::uint64_t seed_, Weight weight_,
+                                     const std::uint64_t segment_size_ = std::uint64_t{ 1 } << 20 ) {
+    using reservoir_t = weighted_reservoir<typename std::iterator_traits<RandomIt>::value_type, Engine>;
+    const std::uint64_t n = std::uint64_t ( std::distance ( first_, last_ ) );
+    std::vector<reservoir_t> shards ( ( n + segment_size_ - 1 ) / segment_size_, reservoir_t ( k_, seed_, segment_size_ ) );
+    std::vector<std::size_t> segments ( shards.size ( ) );
+    std::iota ( segments.begin ( ), segments.end ( ), std::size_t{ 0 } );
+    std::for_each ( std::forward<ExecutionPolicy> ( policy_ ), segments.begin ( ), segments.end ( ), [ & ]( const std::size_t s ) {
+        for ( std::uint64_t i = s * segment_size_, e = std::min ( n, i + segment_size_ ); i < e; ++i )
+            shards[ s ].push ( i, first_[ i ], weight_ ( first_[ i ] ) );
+    } );
+    reservoir_t all ( k_, seed_, segment_size_ );
+    for ( const reservoir_t & r : shards )
+        all.merge ( r );
+    return all.sample ( );
+}
+
+} // namespace rng
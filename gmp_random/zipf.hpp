@@ -0,0 +1,169 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "block.hpp"
+#include "parallel_generate.hpp"
+
+// Zipf ( n, s ) distributions, k in [ 1, n ] with probability proportional to
+// k^-s, s >= 0.
+//
+// zipf_distribution is Hörmann and Derflinger's rejection-inversion: it
+// inverts the integral of the hat x^-s, a continuous density over the
+// probabilities, and accepts the rounded value unless it fell in the part of
+// the hat's area above k^-s. That's O ( 1 ) expected time ( well below 2 uniforms
+// a value, at any n and s ) and no table, for n up to 2^64. zipf_table_distribution
+// draws from an alias table of the n probabilities, one value a sample, for
+// small n. fill ( engine, out ) draws the uniforms a block at a time.
+
+namespace zipf_detail {
+
+// log ( 1 + x_ ) / x_, and ( e^x_ - 1 ) / x_, with their series near 0.
+[[nodiscard]] inline double log1p_over ( const double x_ ) noexcept {
+    return std::abs ( x_ ) > 1e-8 ? std::log1p ( x_ ) / x_ : 1.0 - x_ * ( 0.5 - x_ * ( 1.0 / 3.0 - 0.25 * x_ ) );
+}
+[[nodiscard]] inline double expm1_over ( const double x_ ) noexcept {
+    return std::abs ( x_ ) > 1e-8 ? std::expm1 ( x_ ) / x_ : 1.0 + x_ * 0.5 * ( 1.0 + x_ / 3.0 * ( 1.0 + 0.25 * x_ ) );
+}
+
+// The top 53 bits of 64 from engine_, in [ 0, 1 ).
+template<typename Engine>
+[[nodiscard]] double uniform ( Engine & engine_ ) {
+    return double ( rng::draw_key ( engine_ ) >> 11 ) * 0x1p-53;
+}
+
+} // namespace zipf_detail
+
+class zipf_distribution {
+    public:
+    using result_type = std::uint64_t;
+
+    zipf_distribution ( const std::uint64_t n_, const double s_ ) noexcept :
+        _n ( n_ ), _s ( s_ ), _h_x1 ( hat_integral ( 1.5 ) - 1.0 ), _h_n ( hat_integral ( double ( n_ ) + 0.5 ) ),
+        _squeeze ( 2.0 - hat_integral_inverse ( hat_integral ( 2.5 ) - hat ( 2.0 ) ) ) {
+        assert ( n_ > 0 and s_ >= 0.0 );
+    }
+
+    [[nodiscard]] result_type min ( ) const noexcept { return 1; }
+    [[nodiscard]] result_type max ( ) const noexcept { return _n; }
+
+    template<typename Engine>
+    [[nodiscard]] result_type operator( ) ( Engine & engine_ ) const {
+        for ( ;; ) {
+            const double u = _h_n + zipf_detail::uniform ( engine_ ) * ( _h_x1 - _h_n ), x = hat_integral_inverse ( u );
+            const result_type k = x < 1.5 ? 1 : x + 0.5 >= double ( _n ) ? _n : result_type ( x + 0.5 );
+            if ( double ( k ) - x <= _squeeze or u >= hat_integral ( double ( k ) + 0.5 ) - hat ( double ( k ) ) )
+                return k;
+        }
+    }
+
+    template<typename Engine>
+    void fill ( Engine & engine_, const std::span<result_type> out_ ) const {
+        block_buffer<Engine> buffer ( engine_ );
+        for ( result_type & k : out_ )
+            k = operator( ) ( buffer );
+    }
+
+    private:
+    std::uint64_t _n;
+    double _s, _h_x1, _h_n, _squeeze;
+
+    [[nodiscard]] double hat ( const double x_ ) const noexcept { return std::exp ( -_s * std::log ( x_ ) ); }
+    // The integral of the hat, ( x^( 1 - s ) - 1 ) / ( 1 - s ), log x at s = 1,
+    // and its inverse.
+    [[nodiscard]] double hat_integral ( const double x_ ) const noexcept {
+        const double l = std::log ( x_ );
+        return zipf_detail::expm1_over ( ( 1.0 - _s ) * l ) * l;
+    }
+    [[nodiscard]] double hat_integral_inverse ( const double x_ ) const noexcept {
+        const double t = std::max ( x_ * ( 1.0 - _s ), -1.0 );
+        return std::exp ( zipf_detail::log1p_over ( t ) * x_ );
+    }
+};
+
+// Vose's alias table: slot i keeps i with probability threshold[ i ] / 2^64,
+// else gives alias[ i ]. A sample takes one 64-bit value, its high part
+// ( times n ) picks the slot, its low part decides.
+class zipf_table_distribution {
+    public:
+    using result_type = std::uint64_t;
+
+    zipf_table_distribution ( const std::uint32_t n_, const double s_ ) : _threshold ( n_ ), _alias ( n_ ) {
+        assert ( n_ > 0 and s_ >= 0.0 );
+        std::vector<double> p ( n_ );
+        double sum = 0.0;
+        for ( std::uint32_t k = n_; k; --k ) // Smallest first.
+            sum += p[ k - 1 ] = std::pow ( double ( k ), -s_ );
+        std::vector<std::uint32_t> small, large;
+        for ( std::uint32_t i = 0; i < n_; ++i ) {
+            p[ i ] *= n_ / sum;
+            ( p[ i ] < 1.0 ? small : large ).push_back ( i );
+        }
+        while ( small.size ( ) and large.size ( ) ) {
+            const std::uint32_t s = small.back ( ), l = large.back ( );
+            small.pop_back ( );
+            _threshold[ s ] = std::uint64_t ( p[ s ] * 0x1p64 );
+            _alias[ s ]     = l;
+            p[ l ] -= 1.0 - p[ s ];
+            if ( p[ l ] < 1.0 ) {
+                large.pop_back ( );
+                small.push_back ( l );
+            }
+        }
+        for ( const std::uint32_t i : small ) // 1 but for rounding.
+            _threshold[ i ] = ~std::uint64_t{ 0 }, _alias[ i ] = i;
+        for ( const std::uint32_t i : large )
+            _threshold[ i ] = ~std::uint64_t{ 0 }, _alias[ i ] = i;
+    }
+
+    [[nodiscard]] result_type min ( ) const noexcept { return 1; }
+    [[nodiscard]] result_type max ( ) const noexcept { return _alias.size ( ); }
+
+    template<typename Engine>
+    [[nodiscard]] result_type operator( ) ( Engine & engine_ ) const {
+        const __uint128_t x   = __uint128_t{ rng::draw_key ( engine_ ) } * _alias.size ( );
+        const std::size_t i   = std::size_t ( x >> 64 );
+        return 1 + ( std::uint64_t ( x ) < _threshold[ i ] ? i : _alias[ i ] );
+    }
+
+    template<typename Engine>
+    void fill ( Engine & engine_, const std::span<result_type> out_ ) const {
+        block_buffer<Engine> buffer ( engine_ );
+        for ( result_type & k : out_ )
+            k = operator( ) ( buffer );
+    }
+
+    private:
+    std::vector<std::uint64_t> _threshold;
+    std::vector<std::uint32_t> _alias;
+};